@@ -1,55 +1,334 @@
 #include "chessGame.hh"
+#include <array>
+#include <cstddef>
 #include <sdl_wrapper/colors.hh>
 
 namespace chess
 {
-ChessGame::ChessGame(int xGridAmount, int yGridAmount)
+/**
+ * @brief The color of the light squares of the board.
+ *
+ */
+static constexpr SDL_Color LIGHT_SQUARE_COLOR = {0xaa, 0xaa, 0xaa, 0xff};
+/**
+ * @brief The color of the dark squares of the board.
+ *
+ */
+static constexpr SDL_Color DARK_SQUARE_COLOR = {0x77, 0x77, 0x77, 0xff};
+/**
+ * @brief The tint of the square the mouse is over.
+ *
+ */
+static constexpr SDL_Color HOVER_COLOR = {0xff, 0xff, 0xff, 0x30};
+/**
+ * @brief The tint of the selected square.
+ *
+ */
+static constexpr SDL_Color SELECTION_COLOR = {0x20, 0xa0, 0x20, 0x70};
+/**
+ * @brief The color of arrows.
+ *
+ */
+static constexpr SDL_Color ARROW_COLOR = {0xe0, 0x80, 0x10, 0xc0};
+
+ChessGame::ChessGame(int xGridAmount, int yGridAmount, PieceRegistry pieces)
+    : geometry(xGridAmount, yGridAmount), pieces(std::move(pieces))
 {
-    grid.resize(xGridAmount * yGridAmount);
-    int i = 0;
-    for (int x = 0; x < xGridAmount; x++)
-    {
-        for (int y = 0; y < yGridAmount; y++)
-        {
-            constexpr SDL_Color LIGHT_GRAY = {0xaa, 0xaa, 0xaa, 0xff};
-            constexpr SDL_Color DARK_GRAY = {0x77, 0x77, 0x77, 0xff};
-            if (x % 2 == y % 2)
-            {
-                grid[i++] = new chess::GridSquare(x, y, LIGHT_GRAY, true);
-            }
-            else
-            {
-                grid[i++] = new chess::GridSquare(x, y, DARK_GRAY, true);
-            }
-        }
-    }
     this->chessBoard = std::nullopt;
+    this->pieceLayer = std::nullopt;
+    this->atlas = std::nullopt;
+    this->hover = rules::NO_SQUARE;
+    this->selection = rules::NO_SQUARE;
+    this->overlayDirty = true;
+    this->damagedAll = true;
     this->squareSize = 0;
+    this->boardSquareSize = 0;
     this->xDisplacement = 0;
     this->yDisplacement = 0;
 }
 
-void ChessGame::redraw(sdl::render::Renderer &rr, int width, int height, int margin, int nCols, int nRows)
+void ChessGame::resize(int width, int height, int margin, int nCols, int nRows)
 {
     constexpr int HUNDRED_PERCENT = 100;
     squareSize = ((HUNDRED_PERCENT - margin * 2) * std::min(height / nRows, width / nCols) / HUNDRED_PERCENT);
     xDisplacement = (width - squareSize * nCols) / 2;
     yDisplacement = (height - squareSize * nRows) / 2;
-    chessBoard = {sdl::render::Texture(rr, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, squareSize * nCols,
-                                       squareSize * nRows)};
+    damagedAll = true;
+}
+
+void ChessGame::redraw(sdl::render::Renderer &rr, int width, int height, int margin, int nCols, int nRows,
+                       bool newTextures)
+{
+    resize(width, height, margin, nCols, nRows);
+    int boardWidth = std::max(squareSize * nCols, 1);
+    int boardHeight = std::max(squareSize * nRows, 1);
+    // keep the texture if the board fits in it, unless it is so large that most of it would go unused
+    bool fits = !newTextures && chessBoard && chessBoard->getWidth() >= boardWidth &&
+                chessBoard->getHeight() >= boardHeight && chessBoard->getWidth() <= 2 * boardWidth &&
+                chessBoard->getHeight() <= 2 * boardHeight;
+    if (!fits)
+    {
+        chessBoard = {
+            sdl::render::Texture(rr, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, boardWidth, boardHeight)};
+        pieceLayer = {
+            sdl::render::Texture(rr, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, boardWidth, boardHeight)};
+        pieceLayer->setBlendMode(SDL_BLENDMODE_BLEND);
+    }
     rr.setTarget(*chessBoard);
     rr.setDrawColor(sdl::colors::Transparent);
     rr.clear();
-    for (auto &square : grid)
+    // fill each color's squares in one call; disabled squares are not on the board, so they stay transparent
+    std::array<SDL_Rect, rules::MAX_SQUARES> lightSquares;
+    std::array<SDL_Rect, rules::MAX_SQUARES> darkSquares;
+    std::size_t lightCount = 0;
+    std::size_t darkCount = 0;
+    for (rules::Square sq : geometry.getOnBoard())
     {
-        square->display(rr, squareSize, 0, 0);
+        int x = geometry.xOf(sq);
+        int y = geometry.yOf(sq);
+        SDL_Rect rect = {x * squareSize, y * squareSize, squareSize, squareSize};
+        if (x % 2 == y % 2)
+        {
+            lightSquares[lightCount++] = rect;
+        }
+        else
+        {
+            darkSquares[darkCount++] = rect;
+        }
     }
+    rr.setDrawColor(LIGHT_SQUARE_COLOR);
+    rr.fillRects({lightSquares.data(), lightCount});
+    rr.setDrawColor(DARK_SQUARE_COLOR);
+    rr.fillRects({darkSquares.data(), darkCount});
+    // empty squares stay transparent; the occupied ones are rendered by the next displayPieces
+    rr.setTarget(*pieceLayer);
+    rr.setDrawColor(sdl::colors::Transparent);
+    rr.clear();
     rr.resetTarget();
+    dirtySquares = position.getOccupied() & geometry.getOnBoard();
+    boardSquareSize = squareSize;
+    atlas.emplace(rr, pieces, squareSize);
 }
 
 void ChessGame::displayGrid(sdl::render::Renderer &rr)
 {
-    rr.copy(*chessBoard, std::nullopt,
-            {{xDisplacement, yDisplacement, chessBoard->getWidth(), chessBoard->getHeight()}});
+    // the board as it was last drawn, stretched to the current size if the window has been resized since
+    rr.copy(*chessBoard, {{0, 0, boardSquareSize * geometry.getWidth(), boardSquareSize * geometry.getHeight()}},
+            {{xDisplacement, yDisplacement, squareSize * geometry.getWidth(), squareSize * geometry.getHeight()}});
+}
+
+void ChessGame::displayPieces(sdl::render::Renderer &rr)
+{
+    if (!dirtySquares.empty())
+    {
+        updatePieceLayer(rr);
+    }
+    // stretched like the board, since the layer is rendered at the board's size
+    rr.copy(*pieceLayer, {{0, 0, boardSquareSize * geometry.getWidth(), boardSquareSize * geometry.getHeight()}},
+            {{xDisplacement, yDisplacement, squareSize * geometry.getWidth(), squareSize * geometry.getHeight()}});
+}
+
+void ChessGame::displayOverlay(sdl::render::Renderer &rr)
+{
+    rr.setBlendMode(SDL_BLENDMODE_BLEND);
+    if (selection != rules::NO_SQUARE)
+    {
+        rr.setDrawColor(SELECTION_COLOR);
+        rr.fillRect(getScreenRect(selection));
+    }
+    if (hover != rules::NO_SQUARE)
+    {
+        rr.setDrawColor(HOVER_COLOR);
+        rr.fillRect(getScreenRect(hover));
+    }
+    if (!arrows.empty())
+    {
+        // a line between the squares' centers, ending in a block a quarter of a square wide
+        int headSize = std::max(squareSize / 4, 1);
+        rr.setDrawColor(ARROW_COLOR);
+        for (auto [from, to] : arrows)
+        {
+            SDL_Rect start = getScreenRect(from);
+            SDL_Rect end = getScreenRect(to);
+            SDL_Point head = {end.x + end.w / 2, end.y + end.h / 2};
+            rr.drawLine({start.x + start.w / 2, start.y + start.h / 2}, head);
+            rr.fillRect({head.x - headSize / 2, head.y - headSize / 2, headSize, headSize});
+        }
+    }
+    overlayDirty = false;
+}
+
+bool ChessGame::needsDisplay() const noexcept
+{
+    return overlayDirty || !dirtySquares.empty();
+}
+
+void ChessGame::damageAll() noexcept
+{
+    damagedAll = true;
+}
+
+sdl::Span<const SDL_Rect> ChessGame::collectDamage(int width, int height)
+{
+    damagedAreas.clear();
+    if (damagedAll)
+    {
+        damagedAreas.push_back({0, 0, width, height});
+    }
+    else if (!damagedSquares.empty())
+    {
+        for (int y = 0; y < geometry.getHeight(); y++)
+        {
+            int x = 0;
+            while (x < geometry.getWidth())
+            {
+                int first = x;
+                while (x < geometry.getWidth() && damagedSquares.test(geometry.squareAt(x, y)))
+                {
+                    x++;
+                }
+                if (x > first)
+                {
+                    damagedAreas.push_back({xDisplacement + first * squareSize, yDisplacement + y * squareSize,
+                                            (x - first) * squareSize, squareSize});
+                }
+                else
+                {
+                    x++;
+                }
+            }
+        }
+    }
+    damagedAll = false;
+    damagedSquares = rules::Bitboard();
+    return damagedAreas;
+}
+
+void ChessGame::setPosition(const rules::Position &newPosition)
+{
+    for (rules::Square sq : geometry.getOnBoard())
+    {
+        if (newPosition.getPieceAt(sq) != position.getPieceAt(sq))
+        {
+            dirtySquares.set(sq);
+            damagedSquares.set(sq);
+        }
+    }
+    position = newPosition;
+}
+
+rules::Square ChessGame::squareAt(int x, int y) const noexcept
+{
+    if (squareSize <= 0 || x < xDisplacement || y < yDisplacement)
+    {
+        return rules::NO_SQUARE;
+    }
+    int column = (x - xDisplacement) / squareSize;
+    int row = (y - yDisplacement) / squareSize;
+    if (!geometry.contains(column, row))
+    {
+        return rules::NO_SQUARE;
+    }
+    rules::Square sq = geometry.squareAt(column, row);
+    return geometry.isEnabled(sq) ? sq : rules::NO_SQUARE;
+}
+
+rules::Square ChessGame::getSelection() const noexcept
+{
+    return selection;
+}
+
+void ChessGame::setHover(rules::Square sq) noexcept
+{
+    if (sq != hover)
+    {
+        damageSquare(hover);
+        damageSquare(sq);
+        overlayDirty = true;
+    }
+    hover = sq;
+}
+
+void ChessGame::setSelection(rules::Square sq) noexcept
+{
+    if (sq != selection)
+    {
+        damageSquare(selection);
+        damageSquare(sq);
+        overlayDirty = true;
+    }
+    selection = sq;
+}
+
+void ChessGame::addArrow(rules::Square from, rules::Square to)
+{
+    arrows.emplace_back(from, to);
+    damageArrow(from, to);
+    overlayDirty = true;
+}
+
+void ChessGame::clearArrows() noexcept
+{
+    overlayDirty = overlayDirty || !arrows.empty();
+    for (auto [from, to] : arrows)
+    {
+        damageArrow(from, to);
+    }
+    arrows.clear();
+}
+
+void ChessGame::updatePieceLayer(sdl::render::Renderer &rr)
+{
+    // the squares' pixels are replaced rather than blended: cleared to transparent, then overwritten by the atlas
+    // cells, which are exactly a square in size
+    std::array<SDL_Rect, rules::MAX_SQUARES> cleared;
+    std::size_t clearedCount = 0;
+    for (rules::Square sq : dirtySquares)
+    {
+        SDL_Rect rect = {geometry.xOf(sq) * boardSquareSize, geometry.yOf(sq) * boardSquareSize, boardSquareSize,
+                         boardSquareSize};
+        cleared[clearedCount++] = rect;
+        rules::PieceCode code = position.getPieceAt(sq);
+        if (code != rules::NO_PIECE)
+        {
+            atlas->add(Piece::fromCode(code), rect);
+        }
+    }
+    rr.setTarget(*pieceLayer);
+    rr.setBlendMode(SDL_BLENDMODE_NONE);
+    rr.setDrawColor(sdl::colors::Transparent);
+    rr.fillRects({cleared.data(), clearedCount});
+    atlas->draw(rr);
+    rr.resetTarget();
+    dirtySquares = rules::Bitboard();
+}
+
+void ChessGame::damageSquare(rules::Square sq) noexcept
+{
+    if (sq != rules::NO_SQUARE)
+    {
+        damagedSquares.set(sq);
+    }
+}
+
+void ChessGame::damageArrow(rules::Square from, rules::Square to) noexcept
+{
+    int left = std::min(geometry.xOf(from), geometry.xOf(to));
+    int right = std::max(geometry.xOf(from), geometry.xOf(to));
+    int top = std::min(geometry.yOf(from), geometry.yOf(to));
+    int bottom = std::max(geometry.yOf(from), geometry.yOf(to));
+    for (int y = top; y <= bottom; y++)
+    {
+        for (int x = left; x <= right; x++)
+        {
+            damagedSquares.set(geometry.squareAt(x, y));
+        }
+    }
+}
+
+SDL_Rect ChessGame::getScreenRect(rules::Square sq) const noexcept
+{
+    return {xDisplacement + geometry.xOf(sq) * squareSize, yDisplacement + geometry.yOf(sq) * squareSize, squareSize,
+            squareSize};
 }
 } // namespace chess
\ No newline at end of file
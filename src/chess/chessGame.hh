@@ -10,7 +10,14 @@
 
 #include <algorithm>
 #include <chess/gridSquare.hh>
+#include <chess/piece_atlas.hh>
+#include <chess/piece_registry.hh>
+#include <optional>
+#include <rules/board_geometry.hh>
+#include <rules/position.hh>
 #include <sdl_wrapper/render/texture.hh>
+#include <sdl_wrapper/span.hh>
+#include <utility>
 #include <vector>
 
 /**
@@ -23,7 +30,16 @@ namespace chess
 /**
  * @brief Represents the environment of a game of chess. Mainly involves the board for now.
  *
- * @todo add pieces
+ * A frame is composited from three layers, each redrawn only when it changes:
+ * 1. The board, rendered into a texture by redraw() and otherwise only copied.
+ * 2. The pieces, rendered into a texture of the board's size. Only the squares whose piece changed since the last
+ *    frame are rendered again; the rest of the layer is copied as it is.
+ * 3. The overlay of the hovered square, the selected square and arrows, which is a handful of shapes drawn straight
+ *    to the screen, so that moving the mouse never touches the other layers.
+ *
+ * Apart from the layers, the game keeps track of which squares of the screen are out of date, for renderers that can
+ * present part of the screen: collectDamage() gives the areas to draw again and present, and forgets them.
+ *
  */
 class ChessGame
 {
@@ -33,10 +49,24 @@ class ChessGame
      *
      * @param xGridAmount the number of columns
      * @param yGridAmount the number of rows
+     * @param pieces the piece types of the game
      */
-    ChessGame(int xGridAmount, int yGridAmount);
+    ChessGame(int xGridAmount, int yGridAmount, PieceRegistry pieces);
     /**
-     * @brief Compute the new size for the board given the screen space.
+     * @brief Compute the new size for the board given the screen space, without drawing it again. Until redraw() is
+     * called, the board and the pieces are stretched from the size they were last drawn at.
+     *
+     * @param width the screen width
+     * @param height the screen height
+     * @param margin the amount of space between the edges of the screen and the edges of the board
+     * @param nCols the number of columns in the board
+     * @param nRows the number of rows in the board
+     */
+    void resize(int width, int height, int margin, int nCols, int nRows);
+    /**
+     * @brief Compute the new size for the board given the screen space, and render the board and the pieces' images
+     * again. The board's and the piece layer's textures are kept if the board still fits in them, unless new ones
+     * are asked for, and every piece is rendered into the piece layer again by the next displayPieces().
      *
      * @param rr the renderer to redraw the texture with
      * @param width the screen width
@@ -44,31 +74,206 @@ class ChessGame
      * @param margin the amount of space between the edges of the screen and the edges of the board
      * @param nCols the number of columns in the board
      * @param nRows the number of rows in the board
+     * @param newTextures whether to create every texture anew, such as after the render device was reset and the old
+     * ones were lost
      */
-    void redraw(sdl::render::Renderer &rr, int width, int height, int margin, int nCols, int nRows);
+    void redraw(sdl::render::Renderer &rr, int width, int height, int margin, int nCols, int nRows,
+                bool newTextures = false);
     /**
      * @brief Display the grid using the renderer provided.
      *
      * @param rr the renderer
      */
     void displayGrid(sdl::render::Renderer &rr);
+    /**
+     * @brief Display the pieces on the board using the renderer provided. The squares whose piece changed are
+     * rendered into the piece layer in one batch from the piece atlas, and the layer is then copied as a whole.
+     *
+     * @param rr the renderer
+     */
+    void displayPieces(sdl::render::Renderer &rr);
+    /**
+     * @brief Display the hovered square, the selected square and the arrows using the renderer provided.
+     *
+     * @param rr the renderer
+     */
+    void displayOverlay(sdl::render::Renderer &rr);
+    /**
+     * @brief Check whether a layer changed since it was last displayed, so the frame on screen is out of date.
+     *
+     * @return true the pieces or the overlay changed
+     * @return false the frame on screen is up to date
+     */
+    bool needsDisplay() const noexcept;
+    /**
+     * @brief Mark the whole screen as out of date, such as when the window has been uncovered.
+     *
+     */
+    void damageAll() noexcept;
+    /**
+     * @brief Get the areas of the screen that are out of date, and mark them as up to date. Each row's run of
+     * adjacent damaged squares is one area.
+     *
+     * @param width the screen width
+     * @param height the screen height
+     * @return sdl::Span<const SDL_Rect> the areas, valid until the next call; the whole screen if damageAll() was
+     * called or the board was resized
+     */
+    sdl::Span<const SDL_Rect> collectDamage(int width, int height);
+
+    /**
+     * @brief Replace the pieces on the board. Only the squares whose piece differs are rendered again.
+     *
+     * @param newPosition the position, on a board of the game's size
+     */
+    void setPosition(const rules::Position &newPosition);
+    /**
+     * @brief Find the square at a point on the screen.
+     *
+     * @param x the x coordinate of the point
+     * @param y the y coordinate of the point
+     * @return rules::Square the square, or rules::NO_SQUARE if the point is not on a square in play
+     */
+    rules::Square squareAt(int x, int y) const noexcept;
+    /**
+     * @brief Get the selected square.
+     *
+     * @return rules::Square the square, or rules::NO_SQUARE if no square is selected
+     */
+    rules::Square getSelection() const noexcept;
+    /**
+     * @brief Set the square the mouse is over.
+     *
+     * @param sq the square, or rules::NO_SQUARE for none
+     */
+    void setHover(rules::Square sq) noexcept;
+    /**
+     * @brief Set the selected square.
+     *
+     * @param sq the square, or rules::NO_SQUARE for none
+     */
+    void setSelection(rules::Square sq) noexcept;
+    /**
+     * @brief Draw an arrow between the centers of two squares.
+     *
+     * @param from the square the arrow starts at
+     * @param to the square the arrow points to
+     */
+    void addArrow(rules::Square from, rules::Square to);
+    /**
+     * @brief Remove every arrow.
+     *
+     */
+    void clearArrows() noexcept;
 
   protected:
     /**
-     * @brief The chess board. Contains grid square objects.
+     * @brief Render the pieces of the squares in `dirtySquares` into `pieceLayer` again, and mark them clean.
+     *
+     * @param rr the renderer
+     */
+    void updatePieceLayer(sdl::render::Renderer &rr);
+    /**
+     * @brief Mark a square of the screen as out of date.
+     *
+     * @param sq the square, or rules::NO_SQUARE to do nothing
+     */
+    void damageSquare(rules::Square sq) noexcept;
+    /**
+     * @brief Mark the squares an arrow may cover as out of date: the rectangle of squares between its ends.
+     *
+     * @param from the square the arrow starts at
+     * @param to the square the arrow points to
+     */
+    void damageArrow(rules::Square from, rules::Square to) noexcept;
+    /**
+     * @brief Get where a square is on the screen.
+     *
+     * @param sq the square
+     * @return SDL_Rect the square's rectangle in screen coordinates
+     */
+    SDL_Rect getScreenRect(rules::Square sq) const noexcept;
+
+    /**
+     * @brief The shape of the chess board, including which squares are in play.
      *
      */
-    std::vector<chess::GridSquare *> grid;
+    rules::BoardGeometry geometry;
+    /**
+     * @brief The pieces on the chess board.
+     *
+     */
+    rules::Position position;
+    /**
+     * @brief The piece types of the game.
+     *
+     */
+    PieceRegistry pieces;
     /**
      * @brief A rendered chess board to use in displayGrid.
      *
      */
     std::optional<sdl::render::Texture> chessBoard;
+    /**
+     * @brief The pieces as they were last rendered, at the size of `chessBoard`, to use in displayPieces.
+     *
+     */
+    std::optional<sdl::render::Texture> pieceLayer;
+    /**
+     * @brief The pieces' images at the size of a grid square, to render `pieceLayer` with.
+     *
+     */
+    std::optional<PieceAtlas> atlas;
+    /**
+     * @brief The squares whose piece changed since `pieceLayer` was last rendered.
+     *
+     */
+    rules::Bitboard dirtySquares;
+    /**
+     * @brief The square the mouse is over, or rules::NO_SQUARE.
+     *
+     */
+    rules::Square hover;
+    /**
+     * @brief The selected square, or rules::NO_SQUARE.
+     *
+     */
+    rules::Square selection;
+    /**
+     * @brief The arrows to draw, as the squares they start and end at.
+     *
+     */
+    std::vector<std::pair<rules::Square, rules::Square>> arrows;
+    /**
+     * @brief Whether the overlay changed since it was last displayed.
+     *
+     */
+    bool overlayDirty;
+    /**
+     * @brief The squares of the screen that are out of date.
+     *
+     */
+    rules::Bitboard damagedSquares;
+    /**
+     * @brief Whether the whole screen is out of date.
+     *
+     */
+    bool damagedAll;
+    /**
+     * @brief The areas returned by collectDamage. Kept between calls so that their memory is reused.
+     *
+     */
+    std::vector<SDL_Rect> damagedAreas;
     /**
      * @brief The size of each grid square in pixels.
      *
      */
     int squareSize;
+    /**
+     * @brief The size of each grid square in pixels when the board was last drawn into `chessBoard`.
+     *
+     */
+    int boardSquareSize;
     /**
      * @brief The displacement in the x direction from the left-hand edge of the screen.
      *
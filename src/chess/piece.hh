@@ -1,111 +1,105 @@
 /**
  * @file piece.hh
  * @author Kyle Coffey (kylecoffey1999@gmail.com)
- * @brief Contains an abstract class through which chess pieces can be defined
+ * @brief Contains the Piece class
  * @date 2020-06-22
  */
 
 #ifndef CHESS_PIECE_HH
 #define CHESS_PIECE_HH
 
-#include <SDL2/SDL_rect.h>
-#include <SDL2/SDL_video.h>
-#include <chess/piece_images.hh>
-#include <sdl_wrapper/primitives/point.hh>
-#include <set>
+#include <rules/types.hh>
 
 namespace chess
 {
-
-class PieceFactory;
-
 /**
- * @brief An abstract chess piece. Pieces have a way to display themselves, a crown (if they are the
- * piece that needs to be checkmated), a selected state, a set of valid moves, and a color (typically
- * white or black).
+ * @brief A chess piece, stored in one byte: a dense piece type ID and a color.
+ *
+ * The type ID is the piece's index in a PieceRegistry, which owns the piece's moves and images, so a piece carries no
+ * references and can be copied freely. Whether a piece wears a crown is part of the position, not the piece; see
+ * rules::Position.
  *
  */
 class Piece
 {
   public:
     /**
-     * @brief Render the piece to the screen.
+     * @brief Construct a piece.
      *
+     * @param type the piece's type, its index in the registry
+     * @param color the piece's color
      */
-    void display();
+    constexpr Piece(rules::PieceType type, rules::Color color) : code(rules::makePiece(color, type))
+    {
+    }
+
     /**
-     * @brief Give this piece a crown. Only one piece should have a crown.
-     * The piece with the crown will lose the game if it is checkmated.
+     * @brief Recreate a piece from the code returned by getCode().
      *
+     * @param code the code, which must not be rules::NO_PIECE
+     * @return Piece the piece
      */
-    void giveCrown();
+    static constexpr Piece fromCode(rules::PieceCode code)
+    {
+        return Piece(rules::typeOf(code), rules::colorOf(code));
+    }
+
     /**
-     * @brief Take the crown from this piece in order to give it to another.
+     * @brief Get the piece's type.
      *
+     * @return rules::PieceType the type, its index in the registry
      */
-    void takeCrown();
+    constexpr rules::PieceType getType() const
+    {
+        return rules::typeOf(code);
+    }
     /**
-     * @brief Check if this piece has a crown.
+     * @brief Get the piece's color.
      *
-     * @return true the piece has a crown
-     * @return false the piece does not have a crown
+     * @return rules::Color the color
      */
-    bool hasCrown() const;
+    constexpr rules::Color getColor() const
+    {
+        return rules::colorOf(code);
+    }
     /**
-     * @brief Get the valid moves for this piece. Valid moves are relative to the
-     * piece's current position. Positive y values represent the forward direction.
-     * For white, this is up (-y). For black, it is down (+y).
-     * Negative x values represent the left direction. For white, this is left (-x). For black,
-     * it is right (+x).
+     * @brief Get the piece packed into one byte, as a rules::Position stores it.
      *
-     * @return std::vector<SDL_Point>
+     * @return rules::PieceCode the code
      */
-    std::vector<SDL_Point> getValidMoves();
+    constexpr rules::PieceCode getCode() const
+    {
+        return code;
+    }
     /**
-     * @brief Check that a specific move is valid for the piece.
+     * @brief Compare two pieces.
      *
-     * @param relMove the move relative to the piece's current position
-     * @return true the move is valid
-     * @return false the move is not valid
+     * @param other the other piece
+     * @return true the pieces have the same type and color
+     * @return false the pieces differ
      */
-    bool validateMove(SDL_Point relMove);
-
+    constexpr bool operator==(Piece other) const
+    {
+        return code == other.code;
+    }
     /**
-     * @brief The piece factory is allowed to call the private constructor of Piece.
+     * @brief Compare two pieces.
      *
+     * @param other the other piece
+     * @return true the pieces differ
+     * @return false the pieces have the same type and color
      */
-    friend class PieceFactory;
+    constexpr bool operator!=(Piece other) const
+    {
+        return code != other.code;
+    }
 
   private:
-    Piece(PieceFactory &factory, const std::set<sdl::primitives::Point> &validMoves, const PieceImages &images,
-          SDL_Color color);
-    /**
-     * @brief The piece's color, typically white or black
-     *
-     */
-    SDL_Color color;
-    /**
-     * @brief Whether the piece has a crown. The piece with the crown is the piece that needs to be
-     * checkmated to win the game.
-     *
-     */
-    bool hasCrown_;
-    /**
-     * @brief The moves that are valid for this piece. Moves are SDL_Points centered around the piece's current
-     * position.
-     *
-     */
-    const std::set<sdl::primitives::Point> &validMoves;
-    /**
-     * @brief The images of this piece, for blitting to the screen. They are owned by its factory.
-     *
-     */
-    const PieceImages &images;
     /**
-     * @brief The factory that created this piece. Useful in play for re-rendering a piece.
+     * @brief The type and color, packed by rules::makePiece().
      *
      */
-    PieceFactory &factory;
+    rules::PieceCode code;
 };
 } // namespace chess
 
@@ -0,0 +1,110 @@
+#include "piece_atlas.hh"
+#include <algorithm>
+#include <optional>
+#include <sdl_wrapper/colors.hh>
+#include <utility>
+
+namespace chess
+{
+/**
+ * @brief Get the number of cells in each row of an atlas, making it about as tall as it is wide.
+ *
+ * @param pieces the piece types, two cells each
+ * @return int the number of columns
+ */
+static int columnsFor(const PieceRegistry &pieces)
+{
+    int cells = std::max(pieces.size() * rules::COLOR_COUNT, 1);
+    int columns = 1;
+    while (columns * columns < cells)
+    {
+        columns++;
+    }
+    return columns;
+}
+
+/**
+ * @brief Get the number of rows of cells in an atlas.
+ *
+ * @param pieces the piece types, two cells each
+ * @return int the number of rows
+ */
+static int rowsFor(const PieceRegistry &pieces)
+{
+    int cells = std::max(pieces.size() * rules::COLOR_COUNT, 1);
+    int columns = columnsFor(pieces);
+    return (cells + columns - 1) / columns;
+}
+
+PieceAtlas::PieceAtlas(sdl::render::WeakRenderer renderer, const PieceRegistry &pieces, int cellSize)
+    : texture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, columnsFor(pieces) * std::max(cellSize, 1),
+              rowsFor(pieces) * std::max(cellSize, 1)),
+      cellSize(std::max(cellSize, 1)), columns(columnsFor(pieces))
+{
+    renderer.setTarget(texture);
+    renderer.setDrawColor(sdl::colors::Transparent);
+    renderer.clear();
+    for (rules::PieceType type = 0; type < pieces.size(); type++)
+    {
+        for (rules::Color color : {rules::Color::White, rules::Color::Black})
+        {
+            sdl::render::Texture image(renderer, pieces.getFactory(type).getSurface(color));
+            // copy the pixels as they are, rather than blending them with the transparent cell
+            image.setBlendMode(SDL_BLENDMODE_NONE);
+            // fit the image to its cell, keeping its aspect ratio, and center it
+            SDL_Rect cell = getSourceRect(Piece(type, color));
+            int longest = std::max(std::max(image.getWidth(), image.getHeight()), 1);
+            int width = image.getWidth() * this->cellSize / longest;
+            int height = image.getHeight() * this->cellSize / longest;
+            renderer.copy(image, std::nullopt,
+                          {{cell.x + (cell.w - width) / 2, cell.y + (cell.h - height) / 2, width, height}});
+        }
+    }
+    renderer.resetTarget();
+    // the cells are drawn over cleared squares, so their pixels replace what is there
+    texture.setBlendMode(SDL_BLENDMODE_NONE);
+}
+
+int PieceAtlas::getCellSize() const noexcept
+{
+    return cellSize;
+}
+
+SDL_Rect PieceAtlas::getSourceRect(Piece piece) const noexcept
+{
+    int cell = piece.getCode();
+    return {cell % columns * cellSize, cell / columns * cellSize, cellSize, cellSize};
+}
+
+const sdl::render::Texture &PieceAtlas::getTexture() const noexcept
+{
+    return texture;
+}
+
+void PieceAtlas::add(Piece piece, SDL_Rect dest)
+{
+    constexpr SDL_Color OPAQUE_WHITE = {0xff, 0xff, 0xff, 0xff};
+    SDL_Rect src = getSourceRect(piece);
+    float width = static_cast<float>(texture.getWidth());
+    float height = static_cast<float>(texture.getHeight());
+    int first = static_cast<int>(vertices.size());
+    // the corners clockwise from the top left, each mapped to the same corner of the piece's cell
+    for (auto [x, y] : {std::pair{0, 0}, std::pair{1, 0}, std::pair{1, 1}, std::pair{0, 1}})
+    {
+        SDL_FPoint position = {static_cast<float>(dest.x + x * dest.w), static_cast<float>(dest.y + y * dest.h)};
+        SDL_FPoint texCoord = {(src.x + x * src.w) / width, (src.y + y * src.h) / height};
+        vertices.push_back(SDL_Vertex{position, OPAQUE_WHITE, texCoord});
+    }
+    indices.insert(indices.end(), {first, first + 1, first + 2, first, first + 2, first + 3});
+}
+
+void PieceAtlas::draw(sdl::render::WeakRenderer renderer)
+{
+    if (!indices.empty())
+    {
+        renderer.drawGeometry(texture, vertices, indices);
+    }
+    vertices.clear();
+    indices.clear();
+}
+} // namespace chess
@@ -0,0 +1,106 @@
+/**
+ * @file piece_atlas.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains the PieceAtlas class
+ * @date 2026-10-17
+ */
+
+#ifndef CHESS_PIECE_ATLAS_HH
+#define CHESS_PIECE_ATLAS_HH
+
+#include <chess/piece.hh>
+#include <chess/piece_registry.hh>
+#include <sdl_wrapper/render/texture.hh>
+#include <sdl_wrapper/render/weak_renderer.hh>
+#include <vector>
+
+namespace chess
+{
+/**
+ * @brief The images of every piece of a registry, scaled to one size and packed into a single texture, so that the
+ * pieces on a board are drawn in one call with one texture rather than one call per piece.
+ *
+ * The atlas is a grid of square cells, one per piece code, each holding its piece's image fitted to the cell. A piece
+ * is drawn by queueing the cell's source rectangle with add(), and the queue is submitted as one batch of triangles
+ * by draw(). The cells are drawn unblended, replacing the pixels under them transparent margins and all, so they are
+ * meant to be drawn at their own size onto a layer, such as ChessGame's piece layer, that is composited later. Since
+ * the images are scaled when the atlas is built, it should be built again when the size the pieces are drawn at
+ * changes, or when render targets are reset.
+ *
+ */
+class PieceAtlas
+{
+  public:
+    /**
+     * @brief Render every piece's images into a new atlas.
+     *
+     * @param renderer the renderer to create the atlas with; its target is reset afterward
+     * @param pieces the piece types
+     * @param cellSize the width and height in pixels of each piece's image in the atlas
+     */
+    PieceAtlas(sdl::render::WeakRenderer renderer, const PieceRegistry &pieces, int cellSize);
+
+    /**
+     * @brief Get the size of each piece's image in the atlas.
+     *
+     * @return int the width and height in pixels
+     */
+    int getCellSize() const noexcept;
+    /**
+     * @brief Get where a piece's image is in the atlas.
+     *
+     * @param piece the piece, whose type must be in the registry the atlas was built from
+     * @return SDL_Rect the image's rectangle in getTexture()
+     */
+    SDL_Rect getSourceRect(Piece piece) const noexcept;
+    /**
+     * @brief Get the atlas texture.
+     *
+     * @return const sdl::render::Texture& the texture
+     */
+    const sdl::render::Texture &getTexture() const noexcept;
+
+    /**
+     * @brief Queue a piece to be drawn by the next draw().
+     *
+     * @param piece the piece
+     * @param dest where to draw it on the render target
+     */
+    void add(Piece piece, SDL_Rect dest);
+    /**
+     * @brief Draw every queued piece in one call, and empty the queue.
+     *
+     * @param renderer the renderer to draw with
+     */
+    void draw(sdl::render::WeakRenderer renderer);
+
+  private:
+    /**
+     * @brief The atlas texture.
+     *
+     */
+    sdl::render::Texture texture;
+    /**
+     * @brief The width and height in pixels of each cell.
+     *
+     */
+    int cellSize;
+    /**
+     * @brief The number of cells in each row of the atlas.
+     *
+     */
+    int columns;
+    /**
+     * @brief The corners of the queued pieces, four per piece. Kept between draws so that their memory is reused.
+     *
+     */
+    std::vector<SDL_Vertex> vertices;
+    /**
+     * @brief The two triangles of each queued piece, as indices into `vertices`.
+     *
+     */
+    std::vector<int> indices;
+};
+} // namespace chess
+
+#endif // CHESS_PIECE_ATLAS_HH
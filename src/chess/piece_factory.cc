@@ -3,35 +3,30 @@
 
 namespace chess
 {
-PieceFactory::PieceFactory(std::set<sdl::primitives::Point> validMoves, sdl::surface::Surface whiteSurface,
+PieceFactory::PieceFactory(std::vector<rules::Offset> moves, sdl::surface::Surface whiteSurface,
                            sdl::surface::Surface blackSurface)
-    : whiteSurface(std::move(whiteSurface)), blackSurface(std::move(blackSurface)), validMoves(std::move(validMoves)),
-      images(nullptr)
+    : whiteSurface(std::move(whiteSurface)), blackSurface(std::move(blackSurface)), moves(std::move(moves)),
+      attackTable(std::nullopt)
 {
 }
 
-void PieceFactory::render(sdl::render::WeakRenderer renderer)
+void PieceFactory::compile(const rules::BoardGeometry &geometry)
 {
-    if (images == nullptr)
-    {
-        sdl::render::Texture whiteTexture(renderer, whiteSurface);
-        sdl::render::Texture blackTexture(renderer, blackSurface);
-        images = std::make_unique<PieceImages>(PieceImages{std::move(whiteTexture), std::move(blackTexture)});
-    }
-    else
-    {
-        images->whiteImage = sdl::render::Texture(renderer, whiteSurface);
-        images->blackImage = sdl::render::Texture(renderer, blackSurface);
-    }
+    attackTable.emplace(geometry, moves);
 }
 
-Piece PieceFactory::getPiece(SDL_Color color)
+const rules::AttackTable &PieceFactory::getAttackTable() const
 {
-    if (images == nullptr)
+    if (!attackTable)
     {
-        throw std::runtime_error(
-            "Cannot create piece: images have not been rendered. Try calling PieceFactory::render()!");
+        throw std::runtime_error("Cannot get attack table: moves have not been compiled. Try calling "
+                                 "PieceFactory::compile()!");
     }
-    return Piece(*this, validMoves, *images, color);
+    return *attackTable;
+}
+
+sdl::surface::WeakSurface PieceFactory::getSurface(rules::Color color) const
+{
+    return color == rules::Color::White ? whiteSurface : blackSurface;
 }
 } // namespace chess
\ No newline at end of file
@@ -8,20 +8,21 @@
 #ifndef CHESS_PIECE_FACTORY_HH
 #define CHESS_PIECE_FACTORY_HH
 
-#include <SDL2/SDL_rect.h>
-#include <chess/piece.hh>
-#include <chess/piece_images.hh>
-#include <memory>
-#include <sdl_wrapper/primitives/point.hh>
-#include <set>
-
+#include <optional>
+#include <rules/attack_table.hh>
+#include <rules/board_geometry.hh>
+#include <rules/types.hh>
+#include <sdl_wrapper/surface/surface.hh>
+#include <vector>
 
 namespace chess
 {
 /**
- * @brief Creates Pieces of a certain type. This type is defined by the constructor of the PieceFactory.
+ * @brief Holds everything about one type of piece: its moves and its images. Pieces of the type refer to it by its
+ * index in a PieceRegistry.
  *
- * The PieceFactory owns the images for its pieces. When render targets are reset, they should be reloaded.
+ * The PieceFactory owns the images for its pieces, which are drawn into a PieceAtlas with the other types' images to
+ * be rendered. It also owns its moves compiled into an AttackTable for the board being played on; see compile().
  *
  */
 class PieceFactory
@@ -29,30 +30,37 @@ class PieceFactory
   public:
     /**
      * @brief Construct a new Piece Factory object for a specified piece definition. Pieces
-     * are defined by their set of valid moves and the images that represent them.
+     * are defined by their moves and the images that represent them.
      *
-     * @param validMoves The set of moves that are valid for this piece
+     * @param moves The moves that are valid for this piece, including rider moves
      * @param whiteSurface an image of the white version of this piece
      * @param blackSurface an image of the black version of this piece
      */
-    PieceFactory(std::set<sdl::primitives::Point> validMoves, sdl::surface::Surface whiteSurface,
+    PieceFactory(std::vector<rules::Offset> moves, sdl::surface::Surface whiteSurface,
                  sdl::surface::Surface blackSurface);
 
     /**
-     * @brief Render the images to a texture for hardware-accelerated blitting. Blitting is done
-     * for a Piece, not the factory, but the factory owns the textures.
+     * @brief Compile the valid moves into an attack table for a board. This should be done when the factory
+     * is loaded for a game, and again if the board changes.
+     *
+     * @param geometry the board the pieces will play on
+     */
+    void compile(const rules::BoardGeometry &geometry);
+
+    /**
+     * @brief Get the attack table built by compile().
      *
-     * @param renderer the renderer to create textures with
+     * @return const rules::AttackTable& the attack table
      */
-    void render(sdl::render::WeakRenderer renderer);
+    const rules::AttackTable &getAttackTable() const;
 
     /**
-     * @brief Create a Piece with the specified color.
+     * @brief Get the image of one color of this piece.
      *
      * @param color the color
-     * @return Piece the piece
+     * @return sdl::surface::WeakSurface the image, owned by the factory
      */
-    Piece getPiece(SDL_Color color);
+    sdl::surface::WeakSurface getSurface(rules::Color color) const;
 
   private:
     /**
@@ -66,15 +74,15 @@ class PieceFactory
      */
     sdl::surface::Surface blackSurface;
     /**
-     * @brief The set of valid moves for this piece class.
+     * @brief The valid moves for this piece class.
      *
      */
-    std::set<sdl::primitives::Point> validMoves;
+    std::vector<rules::Offset> moves;
     /**
-     * @brief The Texture versions of whiteSurface and blackSurface.
+     * @brief The valid moves compiled for the current board, or std::nullopt before compile() is called.
      *
      */
-    std::unique_ptr<PieceImages> images;
+    std::optional<rules::AttackTable> attackTable;
 };
 } // namespace chess
 
@@ -0,0 +1,36 @@
+#include "piece_registry.hh"
+#include <stdexcept>
+
+namespace chess
+{
+rules::PieceType PieceRegistry::add(PieceFactory factory)
+{
+    if (factories.size() == rules::MAX_PIECE_TYPES)
+    {
+        throw std::length_error("adding piece type: registry already has the maximum number of piece types");
+    }
+    factories.push_back(std::move(factory));
+    return static_cast<rules::PieceType>(factories.size() - 1);
+}
+
+rules::Variant PieceRegistry::createVariant(const rules::BoardGeometry &geometry)
+{
+    rules::Variant variant(geometry);
+    for (PieceFactory &factory : factories)
+    {
+        factory.compile(geometry);
+        variant.addPieceType(factory.getAttackTable());
+    }
+    return variant;
+}
+
+int PieceRegistry::size() const noexcept
+{
+    return static_cast<int>(factories.size());
+}
+
+const PieceFactory &PieceRegistry::getFactory(rules::PieceType type) const
+{
+    return factories.at(type);
+}
+} // namespace chess
@@ -0,0 +1,70 @@
+/**
+ * @file piece_registry.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains the PieceRegistry class
+ * @date 2026-10-17
+ */
+
+#ifndef CHESS_PIECE_REGISTRY_HH
+#define CHESS_PIECE_REGISTRY_HH
+
+#include <chess/piece.hh>
+#include <chess/piece_factory.hh>
+#include <rules/board_geometry.hh>
+#include <rules/types.hh>
+#include <rules/variant.hh>
+#include <vector>
+
+namespace chess
+{
+/**
+ * @brief The piece types of a game, indexed by their dense type ID. A Piece names its type by this index, so the board
+ * and the rules only store IDs, and a PieceAtlas finds a piece's images by it.
+ *
+ */
+class PieceRegistry
+{
+  public:
+    /**
+     * @brief Add a piece type.
+     *
+     * @param factory the piece type's moves and images
+     * @return rules::PieceType the new type's ID
+     * @throw std::length_error if the registry already has rules::MAX_PIECE_TYPES types
+     */
+    rules::PieceType add(PieceFactory factory);
+
+    /**
+     * @brief Compile every piece type's moves for a board, and create the variant they make up. The variant's type
+     * IDs are the same as the registry's.
+     *
+     * @param geometry the board
+     * @return rules::Variant the variant
+     */
+    rules::Variant createVariant(const rules::BoardGeometry &geometry);
+
+    /**
+     * @brief Get the number of piece types.
+     *
+     * @return int the number of types
+     */
+    int size() const noexcept;
+    /**
+     * @brief Get a piece type.
+     *
+     * @param type the type's ID
+     * @return const PieceFactory& the type's moves and images
+     * @throw std::out_of_range if there is no such type
+     */
+    const PieceFactory &getFactory(rules::PieceType type) const;
+
+  private:
+    /**
+     * @brief The piece types, indexed by ID.
+     *
+     */
+    std::vector<PieceFactory> factories;
+};
+} // namespace chess
+
+#endif // CHESS_PIECE_REGISTRY_HH
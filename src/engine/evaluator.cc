@@ -0,0 +1,73 @@
+#include "evaluator.hh"
+
+namespace engine
+{
+template <typename BB>
+Evaluator<BB>::Evaluator(const rules::BasicVariant<BB> &variant)
+    : typeCount(variant.getPieceTypeCount()), squareCount(variant.getGeometry().getSquareCount()),
+      values(typeCount), squareValues(typeCount * rules::COLOR_COUNT * squareCount)
+{
+    BB onBoard = variant.getGeometry().getOnBoard();
+    for (rules::PieceType type = 0; type < typeCount; type++)
+    {
+        const rules::BasicAttackTable<BB> &table = variant.getAttackTable(type);
+        int totalMobility = 0;
+        for (rules::Square sq : onBoard)
+        {
+            totalMobility += table.getMoves(rules::Color::White, sq, BB()).count();
+        }
+        values[type] = BASE_VALUE + MOBILITY_VALUE * totalMobility / onBoard.count();
+        for (rules::Color color : {rules::Color::White, rules::Color::Black})
+        {
+            for (rules::Square sq : onBoard)
+            {
+                squareValues[(type * rules::COLOR_COUNT + rules::indexOf(color)) * squareCount + sq] =
+                    values[type] + SQUARE_BONUS * table.getMoves(color, sq, BB()).count();
+            }
+        }
+    }
+}
+
+template <typename BB> int Evaluator<BB>::evaluate(const rules::BasicPosition<BB> &position) const
+{
+    int score = getBalance(position);
+    return position.getSideToMove() == rules::Color::White ? score : -score;
+}
+
+template <typename BB> int Evaluator<BB>::getBalance(const rules::BasicPosition<BB> &position) const
+{
+    int score = 0;
+    for (rules::PieceType type = 0; type < typeCount; type++)
+    {
+        for (rules::Square sq : position.getPieces(rules::Color::White, type))
+        {
+            score += getSquareValue(rules::Color::White, type, sq);
+        }
+        for (rules::Square sq : position.getPieces(rules::Color::Black, type))
+        {
+            score -= getSquareValue(rules::Color::Black, type, sq);
+        }
+    }
+    return score;
+}
+
+template <typename BB>
+int Evaluator<BB>::getMoveDelta(rules::Color mover, rules::Move move, const rules::UndoInfo &undo) const noexcept
+{
+    int delta = getSquareValue(mover, undo.moved, move.getTo()) - getSquareValue(mover, undo.moved, move.getFrom());
+    if (undo.captured != rules::NO_PIECE_TYPE)
+    {
+        delta += getSquareValue(rules::opposite(mover), undo.captured, move.getTo());
+    }
+    return mover == rules::Color::White ? delta : -delta;
+}
+
+template <typename BB> int Evaluator<BB>::getValue(rules::PieceType type) const noexcept
+{
+    return values[type];
+}
+
+#define INSTANTIATE(BB) template class Evaluator<BB>;
+RULES_FOR_EACH_BITBOARD(INSTANTIATE)
+#undef INSTANTIATE
+} // namespace engine
@@ -0,0 +1,121 @@
+/**
+ * @file evaluator.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains the Evaluator class template
+ * @date 2026-10-17
+ */
+
+#ifndef ENGINE_EVALUATOR_HH
+#define ENGINE_EVALUATOR_HH
+
+#include <rules/position.hh>
+#include <rules/variant.hh>
+#include <vector>
+
+namespace engine
+{
+/**
+ * @brief Scores positions statically, without searching.
+ *
+ * Pieces in a variant can have any moves, so there are no hand-tuned piece values. Instead, a piece is worth more the
+ * more squares it can move to on an empty board: its base value grows with its average mobility over the whole board,
+ * and each square adds a bonus for the mobility the piece has there. Both parts are folded into one table per (type,
+ * color, square), so evaluating is a sum of table lookups. Since the score is a sum over pieces, a search can also
+ * keep it up to date as moves are made, from getMoveDelta(), instead of evaluating each position from scratch.
+ *
+ * @tparam BB the bitboard type of the board
+ */
+template <typename BB> class Evaluator
+{
+  public:
+    /**
+     * @brief The value of a piece that attacks nothing, in centipawns.
+     *
+     */
+    static constexpr int BASE_VALUE = 50;
+    /**
+     * @brief The value added per square of average mobility, in centipawns.
+     *
+     */
+    static constexpr int MOBILITY_VALUE = 40;
+    /**
+     * @brief The bonus per square a piece attacks from its current square, in centipawns.
+     *
+     */
+    static constexpr int SQUARE_BONUS = 3;
+
+    /**
+     * @brief Build the evaluation tables for a variant.
+     *
+     * @param variant the rules being played
+     */
+    explicit Evaluator(const rules::BasicVariant<BB> &variant);
+
+    /**
+     * @brief Score a position.
+     *
+     * @param position the position
+     * @return int the score in centipawns, from the side to move's point of view
+     */
+    int evaluate(const rules::BasicPosition<BB> &position) const;
+    /**
+     * @brief Score a position from white's point of view.
+     *
+     * @param position the position
+     * @return int the score in centipawns, positive if white is better
+     */
+    int getBalance(const rules::BasicPosition<BB> &position) const;
+    /**
+     * @brief Find how much a move changed getBalance(), from what making it recorded.
+     *
+     * @param mover the side that made the move
+     * @param move the move
+     * @param undo what Position::makeMove() recorded for the move
+     * @return int the change in centipawns, from white's point of view
+     */
+    int getMoveDelta(rules::Color mover, rules::Move move, const rules::UndoInfo &undo) const noexcept;
+    /**
+     * @brief Get the base value of a piece type, used for material and for ordering captures.
+     *
+     * @param type the piece type
+     * @return int the value in centipawns
+     */
+    int getValue(rules::PieceType type) const noexcept;
+    /**
+     * @brief Get the value of a piece standing on a square, including the square bonus.
+     *
+     * @param color the piece's color
+     * @param type the piece's type
+     * @param sq the square
+     * @return int the value in centipawns, from its own side's point of view
+     */
+    int getSquareValue(rules::Color color, rules::PieceType type, rules::Square sq) const noexcept
+    {
+        return squareValues[(type * rules::COLOR_COUNT + rules::indexOf(color)) * squareCount + sq];
+    }
+
+  private:
+    /**
+     * @brief The number of types the tables are built for.
+     *
+     */
+    int typeCount;
+    /**
+     * @brief The number of squares per (type, color) in `squareValues`.
+     *
+     */
+    int squareCount;
+    /**
+     * @brief The base value of each piece type.
+     *
+     */
+    std::vector<int> values;
+    /**
+     * @brief The value of each piece type, of each color, on each square.
+     *
+     */
+    std::vector<int> squareValues;
+};
+} // namespace engine
+
+#endif // ENGINE_EVALUATOR_HH
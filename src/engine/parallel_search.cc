@@ -0,0 +1,120 @@
+#include "parallel_search.hh"
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+namespace engine
+{
+template <typename BB>
+ParallelSearch<BB>::ParallelSearch(const rules::BasicVariant<BB> &variant, TranspositionTable &table, int threads,
+                               bool deterministic)
+    : deterministic(deterministic), table(table), privateTablesUsed(false)
+{
+    if (threads < 1)
+    {
+        throw std::invalid_argument("a search needs at least one thread");
+    }
+    searches.push_back(std::make_unique<Search<BB>>(variant, table, 0));
+    std::vector<const Search<BB> *> helpers;
+    for (int i = 1; i < threads; i++)
+    {
+        TranspositionTable *helperTable = &table;
+        if (deterministic)
+        {
+            // split the shared table's size between the helpers, to bound the memory used and the time to clear it
+            std::size_t megabytes = table.getSize() / (1024 * 1024) / (threads - 1);
+            privateTables.push_back(std::make_unique<TranspositionTable>(megabytes));
+            helperTable = privateTables.back().get();
+        }
+        searches.push_back(std::make_unique<Search<BB>>(variant, *helperTable, i));
+        helpers.push_back(searches.back().get());
+    }
+    // in deterministic mode each thread keeps to its own node limit, since the others' counts depend on timing
+    if (!deterministic)
+    {
+        searches[0]->setHelpers(std::move(helpers));
+    }
+}
+
+template <typename BB>
+SearchResult ParallelSearch<BB>::run(const rules::BasicPosition<BB> &position, const SearchLimits &limits,
+                                     const std::vector<rules::zobrist::Key> &gameHistory)
+{
+    auto startTime = std::chrono::steady_clock::now();
+    // the main search stops the helpers when it finishes, unless each thread must finish its own search
+    SearchLimits helperLimits = deterministic ? limits : SearchLimits();
+
+    bool clearTables = privateTablesUsed;
+    privateTablesUsed = deterministic;
+
+    // clear every stop flag before any thread starts, so that a stop sent to a helper that has not been scheduled yet
+    // still reaches it
+    for (const auto &search : searches)
+    {
+        search->clearStop();
+        if (deterministic)
+        {
+            // start from nothing, so that earlier runs do not change what this one searches
+            search->clearHistory();
+        }
+    }
+    if (deterministic)
+    {
+        table.clear(getThreadCount());
+    }
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < searches.size(); i++)
+    {
+        threads.emplace_back([&, i] {
+            if (clearTables)
+            {
+                // the helpers' tables must start out the same on every run
+                privateTables[i - 1]->clear();
+            }
+            searches[i]->run(position, helperLimits, gameHistory);
+        });
+    }
+    SearchResult result = searches[0]->run(position, limits, gameHistory);
+    if (!deterministic)
+    {
+        for (std::size_t i = 1; i < searches.size(); i++)
+        {
+            searches[i]->stop();
+        }
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    result.nodes = 0;
+    for (const auto &search : searches)
+    {
+        result.nodes += search->getNodes();
+    }
+    result.time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+    return result;
+}
+
+template <typename BB> void ParallelSearch<BB>::stop() noexcept
+{
+    for (const auto &search : searches)
+    {
+        search->stop();
+    }
+}
+
+template <typename BB> void ParallelSearch<BB>::setIterationCallback(std::function<void(const SearchResult &)> callback)
+{
+    searches[0]->setIterationCallback(std::move(callback));
+}
+
+template <typename BB> int ParallelSearch<BB>::getThreadCount() const noexcept
+{
+    return static_cast<int>(searches.size());
+}
+
+#define INSTANTIATE(BB) template class ParallelSearch<BB>;
+RULES_FOR_EACH_BITBOARD(INSTANTIATE)
+#undef INSTANTIATE
+} // namespace engine
@@ -0,0 +1,112 @@
+/**
+ * @file parallel_search.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains the ParallelSearch class template
+ * @date 2026-10-17
+ */
+
+#ifndef ENGINE_PARALLEL_SEARCH_HH
+#define ENGINE_PARALLEL_SEARCH_HH
+
+#include <engine/search.hh>
+#include <engine/transposition_table.hh>
+#include <functional>
+#include <memory>
+#include <rules/position.hh>
+#include <rules/variant.hh>
+#include <rules/zobrist.hh>
+#include <vector>
+
+namespace engine
+{
+/**
+ * @brief A search that uses several threads, by the lazy SMP method.
+ *
+ * Every thread searches the same position with its own Search, and they share work only through the transposition
+ * table: whatever one thread finds, the others pick up when they reach the same position. The calling thread runs the
+ * main search, which owns the limits and whose result is reported; helper threads search until it finishes.
+ *
+ * Sharing the table makes the threads' work depend on timing, so two runs rarely search the same nodes. In
+ * deterministic mode each helper instead gets a private table (an equal share of the shared one's size) and
+ * searches to the same limits as the main search, and the search waits for every thread to finish. Every run also
+ * starts from cleared tables and move ordering statistics, as a new search would. Node counts and results are then
+ * the same on every run without a time limit, which suits benchmarks of throughput, but the threads do not help each
+ * other, and nothing is carried over from one run to the next.
+ *
+ * @tparam BB the bitboard type of the board
+ */
+template <typename BB> class ParallelSearch
+{
+  public:
+    /**
+     * @brief Construct a search for a variant.
+     *
+     * @param variant the rules being played; must outlive the search
+     * @param table the transposition table to use; must outlive the search
+     * @param threads the number of threads to search with, at least 1
+     * @param deterministic whether to make node counts and results reproducible, at the cost of the threads no longer
+     * sharing a table
+     * @throw std::invalid_argument if `threads` is less than 1
+     */
+    ParallelSearch(const rules::BasicVariant<BB> &variant, TranspositionTable &table, int threads,
+                   bool deterministic = false);
+
+    /**
+     * @brief Search a position for the best move. The node count in the result counts every thread.
+     *
+     * @param position the position
+     * @param limits when to stop; a node limit counts every thread's nodes, or each thread's own in deterministic
+     * mode
+     * @param gameHistory the keys of the positions played before `position` in the game, oldest first
+     * @return SearchResult the result of the main search's deepest completed iteration
+     */
+    SearchResult run(const rules::BasicPosition<BB> &position, const SearchLimits &limits,
+                     const std::vector<rules::zobrist::Key> &gameHistory = {});
+    /**
+     * @brief Stop a running search on every thread as soon as possible. Safe to call from any thread.
+     *
+     */
+    void stop() noexcept;
+    /**
+     * @brief Set a function to call with the result of each of the main search's completed iterations.
+     *
+     * @param callback the function
+     */
+    void setIterationCallback(std::function<void(const SearchResult &)> callback);
+    /**
+     * @brief Get the number of threads the search uses.
+     *
+     * @return int the number of threads
+     */
+    int getThreadCount() const noexcept;
+
+  private:
+    /**
+     * @brief Whether the search is in deterministic mode.
+     *
+     */
+    bool deterministic;
+    /**
+     * @brief The shared transposition table, used by the main search.
+     *
+     */
+    TranspositionTable &table;
+    /**
+     * @brief The helpers' private tables, in deterministic mode.
+     *
+     */
+    std::vector<std::unique_ptr<TranspositionTable>> privateTables;
+    /**
+     * @brief Whether the private tables have been searched with since they were last cleared.
+     *
+     */
+    bool privateTablesUsed;
+    /**
+     * @brief One search per thread; the first is the main search.
+     *
+     */
+    std::vector<std::unique_ptr<Search<BB>>> searches;
+};
+} // namespace engine
+
+#endif // ENGINE_PARALLEL_SEARCH_HH
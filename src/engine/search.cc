@@ -0,0 +1,577 @@
+#include "search.hh"
+#include <algorithm>
+#include <cstdlib>
+#include <rules/move_generator.hh>
+
+namespace engine
+{
+/**
+ * @brief How often, in nodes, the search checks its time and node limits.
+ *
+ */
+constexpr std::uint64_t CHECK_INTERVAL = 1024;
+/**
+ * @brief The half-width of the first aspiration window around the previous iteration's score.
+ *
+ */
+constexpr int ASPIRATION_WINDOW = 30;
+/**
+ * @brief The first depth searched with an aspiration window rather than the full window.
+ *
+ */
+constexpr int ASPIRATION_DEPTH = 4;
+/**
+ * @brief The move-ordering score of the transposition table move.
+ *
+ */
+constexpr int TT_MOVE_SCORE = 1 << 30;
+/**
+ * @brief The move-ordering score added to every capture.
+ *
+ */
+constexpr int CAPTURE_SCORE = 1 << 24;
+/**
+ * @brief The move-ordering score of the first killer move. The second killer scores one less.
+ *
+ */
+constexpr int KILLER_SCORE = 1 << 22;
+/**
+ * @brief The cap on history scores, which keeps quiet moves ordered below killers.
+ *
+ */
+constexpr int HISTORY_MAX = 1 << 20;
+
+/**
+ * @brief The number of different depth-skipping patterns used by helper searches.
+ *
+ */
+constexpr int SKIP_PATTERNS = 20;
+/**
+ * @brief For each skipping pattern, the length of the blocks of depths that are alternately searched and skipped.
+ *
+ */
+constexpr int SKIP_SIZE[SKIP_PATTERNS] = {1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
+/**
+ * @brief For each skipping pattern, how far its blocks are offset, so that helpers with the same block size skip
+ * different depths.
+ *
+ */
+constexpr int SKIP_PHASE[SKIP_PATTERNS] = {0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7};
+
+/**
+ * @brief Convert a score to how it is stored in the transposition table. Mate scores are stored relative to the
+ * node rather than the root, so they stay correct when the node is reached at a different ply.
+ *
+ * @param score the score relative to the root
+ * @param ply the node's distance from the root
+ * @return int the score relative to the node
+ */
+static int scoreToTable(int score, int ply)
+{
+    if (score >= MATE_SCORE - MAX_PLY)
+    {
+        return score + ply;
+    }
+    if (score <= -(MATE_SCORE - MAX_PLY))
+    {
+        return score - ply;
+    }
+    return score;
+}
+
+/**
+ * @brief Convert a score from the transposition table to one relative to the root. See scoreToTable().
+ *
+ * @param score the score relative to the node
+ * @param ply the node's distance from the root
+ * @return int the score relative to the root
+ */
+static int scoreFromTable(int score, int ply)
+{
+    if (score >= MATE_SCORE - MAX_PLY)
+    {
+        return score - ply;
+    }
+    if (score <= -(MATE_SCORE - MAX_PLY))
+    {
+        return score + ply;
+    }
+    return score;
+}
+
+/**
+ * @brief Move the highest-scoring move at or after `index` to `index`.
+ *
+ * @param moves the moves
+ * @param scores the moves' scores
+ * @param index the first unsorted index
+ */
+static void pickNext(rules::MoveList &moves, int *scores, int index)
+{
+    int best = index;
+    for (int i = index + 1; i < moves.size(); i++)
+    {
+        if (scores[i] > scores[best])
+        {
+            best = i;
+        }
+    }
+    std::swap(moves[index], moves[best]);
+    std::swap(scores[index], scores[best]);
+}
+
+template <typename BB>
+Search<BB>::Search(const rules::BasicVariant<BB> &variant, TranspositionTable &table, int threadIndex)
+    : variant(variant), table(table), evaluator(variant), threadIndex(threadIndex), stopped(false), nodes(0),
+      history(rules::COLOR_COUNT * variant.getGeometry().getSquareCount() * variant.getGeometry().getSquareCount()),
+      pvLength(), moveStack(MAX_PLY)
+{
+}
+
+template <typename BB>
+SearchResult Search<BB>::run(const rules::BasicPosition<BB> &position, const SearchLimits &limits,
+                             const std::vector<rules::zobrist::Key> &gameHistory)
+{
+    this->limits = limits;
+    startTime = std::chrono::steady_clock::now();
+    nodes.store(0, std::memory_order_relaxed);
+    keys = gameHistory;
+    keys.reserve(gameHistory.size() + MAX_PLY + 1);
+    keys.push_back(position.getKey());
+    for (auto &plyKillers : killers)
+    {
+        plyKillers = {rules::Move(), rules::Move()};
+    }
+    for (int &score : history)
+    {
+        score /= 2;
+    }
+    if (threadIndex == 0)
+    {
+        table.newSearch();
+    }
+
+    SearchResult result;
+    rules::MoveList rootMoves;
+    rules::generateLegalMoves(variant, position, rootMoves);
+    if (rootMoves.empty())
+    {
+        result.score = rules::isInCheck(variant, position, position.getSideToMove()) ? -MATE_SCORE : 0;
+        return result;
+    }
+    // fall back to any legal move if not even the first iteration completes
+    result.bestMove = rootMoves[0];
+    result.pv = {rootMoves[0]};
+    // the only copy of a position the search makes; every other move is made and unmade on it
+    rules::BasicPosition<BB> root = position;
+    stack[0].balance = evaluator.getBalance(root);
+
+    int maxDepth = std::clamp(limits.depth, 1, MAX_PLY - 1);
+    for (int depth = 1; depth <= maxDepth; depth++)
+    {
+        if (threadIndex > 0 && depth > 1)
+        {
+            int pattern = (threadIndex - 1) % SKIP_PATTERNS;
+            if ((depth + SKIP_PHASE[pattern]) / SKIP_SIZE[pattern] % 2 != 0)
+            {
+                continue;
+            }
+        }
+        int score = 0;
+        if (depth < ASPIRATION_DEPTH || isMateScore(result.score))
+        {
+            score = negamax(root, depth, 0, -INFINITE_SCORE, INFINITE_SCORE);
+        }
+        else
+        {
+            // search a narrow window around the last score first, and widen it whenever the score falls outside
+            int window = ASPIRATION_WINDOW;
+            int alpha = std::max(result.score - window, -INFINITE_SCORE);
+            int beta = std::min(result.score + window, INFINITE_SCORE);
+            while (true)
+            {
+                score = negamax(root, depth, 0, alpha, beta);
+                if (stopped.load(std::memory_order_relaxed))
+                {
+                    break;
+                }
+                if (score <= alpha)
+                {
+                    alpha = std::max(score - window, -INFINITE_SCORE);
+                }
+                else if (score >= beta)
+                {
+                    beta = std::min(score + window, INFINITE_SCORE);
+                }
+                else
+                {
+                    break;
+                }
+                window *= 2;
+            }
+        }
+        if (stopped.load(std::memory_order_relaxed))
+        {
+            break;
+        }
+
+        result.bestMove = pvTable[0][0];
+        result.score = score;
+        result.depth = depth;
+        result.pv.assign(pvTable[0].begin(), pvTable[0].begin() + pvLength[0]);
+        result.nodes = totalNodes();
+        result.time =
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+        if (iterationCallback)
+        {
+            iterationCallback(result);
+        }
+
+        // a forced mate cannot be improved by searching deeper
+        if (isMateScore(score) && MATE_SCORE - std::abs(score) <= depth)
+        {
+            break;
+        }
+        // an iteration takes longer than all the ones before it, so don't start one that can't finish
+        if (limits.time.count() > 0 && result.time * 2 > limits.time)
+        {
+            break;
+        }
+    }
+    result.nodes = totalNodes();
+    result.time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+    return result;
+}
+
+template <typename BB> void Search<BB>::stop() noexcept
+{
+    stopped.store(true, std::memory_order_relaxed);
+}
+
+template <typename BB> void Search<BB>::clearStop() noexcept
+{
+    stopped.store(false, std::memory_order_relaxed);
+}
+
+template <typename BB> void Search<BB>::clearHistory() noexcept
+{
+    std::fill(history.begin(), history.end(), 0);
+}
+
+template <typename BB> void Search<BB>::setIterationCallback(std::function<void(const SearchResult &)> callback)
+{
+    iterationCallback = std::move(callback);
+}
+
+template <typename BB> void Search<BB>::setHelpers(std::vector<const Search *> helpers)
+{
+    this->helpers = std::move(helpers);
+}
+
+template <typename BB> std::uint64_t Search<BB>::getNodes() const noexcept
+{
+    return nodes.load(std::memory_order_relaxed);
+}
+
+template <typename BB>
+int Search<BB>::negamax(rules::BasicPosition<BB> &position, int depth, int ply, int alpha, int beta)
+{
+    pvLength[ply] = ply;
+    bool inCheck = rules::isInCheck(variant, position, position.getSideToMove());
+    // don't drop into quiescence while in check, or the side in check could stand pat
+    if (inCheck && ply < MAX_PLY / 2)
+    {
+        depth++;
+    }
+    if (depth <= 0 || ply >= MAX_PLY - 1)
+    {
+        return quiesce(position, ply, alpha, beta);
+    }
+    if (countNode())
+    {
+        return 0;
+    }
+
+    bool pvNode = beta - alpha > 1;
+    if (ply > 0)
+    {
+        if (isRepetition())
+        {
+            return 0;
+        }
+        // no line from here can beat a mate already found closer to the root
+        alpha = std::max(alpha, -MATE_SCORE + ply);
+        beta = std::min(beta, MATE_SCORE - ply - 1);
+        if (alpha >= beta)
+        {
+            return alpha;
+        }
+    }
+
+    rules::zobrist::Key key = position.getKey();
+    TTData ttData;
+    rules::Move ttMove;
+    if (table.probe(key, ttData))
+    {
+        ttMove = ttData.move;
+        int ttScore = scoreFromTable(ttData.score, ply);
+        if (!pvNode && ttData.depth >= depth &&
+            (ttData.bound == Bound::Exact || (ttData.bound == Bound::Lower && ttScore >= beta) ||
+             (ttData.bound == Bound::Upper && ttScore <= alpha)))
+        {
+            return ttScore;
+        }
+    }
+
+    rules::MoveList &moves = moveStack[ply].moves;
+    moves.clear();
+    rules::generateLegalMoves(variant, position, moves);
+    if (moves.empty())
+    {
+        return inCheck ? -MATE_SCORE + ply : 0;
+    }
+    int *scores = moveStack[ply].scores.data();
+    scoreMoves(position, moves, scores, ttMove, ply);
+
+    rules::Color us = position.getSideToMove();
+    BB theirs = position.getPieces(rules::opposite(us));
+    int squareCount = variant.getGeometry().getSquareCount();
+    int originalAlpha = alpha;
+    int bestScore = -INFINITE_SCORE;
+    rules::Move bestMove;
+    for (int i = 0; i < moves.size(); i++)
+    {
+        pickNext(moves, scores, i);
+        rules::Move move = moves[i];
+        bool capture = theirs.test(move.getTo());
+
+        makeMove(position, move, ply);
+        table.prefetch(position.getKey());
+        keys.push_back(position.getKey());
+
+        int score = 0;
+        if (i == 0)
+        {
+            score = -negamax(position, depth - 1, ply + 1, -beta, -alpha);
+        }
+        else
+        {
+            // late quiet moves are unlikely to be best, so search them shallower first
+            int reduction = 0;
+            if (depth >= 3 && i >= 3 && !capture && !inCheck)
+            {
+                reduction = i >= 8 ? 2 : 1;
+            }
+            score = -negamax(position, depth - 1 - reduction, ply + 1, -alpha - 1, -alpha);
+            if (score > alpha && reduction > 0)
+            {
+                score = -negamax(position, depth - 1, ply + 1, -alpha - 1, -alpha);
+            }
+            if (score > alpha && score < beta)
+            {
+                score = -negamax(position, depth - 1, ply + 1, -beta, -alpha);
+            }
+        }
+        keys.pop_back();
+        position.unmakeMove(move, stack[ply].undo);
+        if (stopped.load(std::memory_order_relaxed))
+        {
+            return 0;
+        }
+
+        if (score > bestScore)
+        {
+            bestScore = score;
+            bestMove = move;
+            if (score > alpha)
+            {
+                alpha = score;
+                pvTable[ply][ply] = move;
+                for (int j = ply + 1; j < pvLength[ply + 1]; j++)
+                {
+                    pvTable[ply][j] = pvTable[ply + 1][j];
+                }
+                pvLength[ply] = std::max(pvLength[ply + 1], ply + 1);
+                if (alpha >= beta)
+                {
+                    if (!capture)
+                    {
+                        if (killers[ply][0] != move)
+                        {
+                            killers[ply][1] = killers[ply][0];
+                            killers[ply][0] = move;
+                        }
+                        int &entry =
+                            history[(rules::indexOf(us) * squareCount + move.getFrom()) * squareCount + move.getTo()];
+                        entry = std::min(entry + depth * depth, HISTORY_MAX);
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    Bound bound = bestScore >= beta ? Bound::Lower : bestScore > originalAlpha ? Bound::Exact : Bound::Upper;
+    table.store(key, TTData{bestMove, scoreToTable(bestScore, ply), depth, bound});
+    return bestScore;
+}
+
+template <typename BB> int Search<BB>::quiesce(rules::BasicPosition<BB> &position, int ply, int alpha, int beta)
+{
+    pvLength[ply] = ply;
+    if (countNode())
+    {
+        return 0;
+    }
+    rules::Color us = position.getSideToMove();
+    bool inCheck = rules::isInCheck(variant, position, us);
+    if (ply >= MAX_PLY - 1)
+    {
+        return inCheck ? 0 : evaluate(position, ply);
+    }
+
+    rules::MoveList &moves = moveStack[ply].moves;
+    moves.clear();
+    int bestScore = -INFINITE_SCORE;
+    if (inCheck)
+    {
+        // every move must be considered to escape check
+        rules::generateLegalMoves(variant, position, moves);
+        if (moves.empty())
+        {
+            return -MATE_SCORE + ply;
+        }
+    }
+    else
+    {
+        bestScore = evaluate(position, ply);
+        if (bestScore >= beta)
+        {
+            return bestScore;
+        }
+        alpha = std::max(alpha, bestScore);
+        rules::generateLegalCaptures(variant, position, moves);
+    }
+    int *scores = moveStack[ply].scores.data();
+    scoreMoves(position, moves, scores, rules::Move(), ply);
+
+    for (int i = 0; i < moves.size(); i++)
+    {
+        pickNext(moves, scores, i);
+        makeMove(position, moves[i], ply);
+        int score = -quiesce(position, ply + 1, -beta, -alpha);
+        position.unmakeMove(moves[i], stack[ply].undo);
+        if (stopped.load(std::memory_order_relaxed))
+        {
+            return 0;
+        }
+        if (score > bestScore)
+        {
+            bestScore = score;
+            if (score > alpha)
+            {
+                alpha = score;
+                if (alpha >= beta)
+                {
+                    break;
+                }
+            }
+        }
+    }
+    return bestScore;
+}
+
+template <typename BB>
+void Search<BB>::scoreMoves(const rules::BasicPosition<BB> &position, const rules::MoveList &moves, int *scores,
+                            rules::Move ttMove, int ply) const
+{
+    rules::Color us = position.getSideToMove();
+    BB theirs = position.getPieces(rules::opposite(us));
+    int squareCount = variant.getGeometry().getSquareCount();
+    for (int i = 0; i < moves.size(); i++)
+    {
+        rules::Move move = moves[i];
+        if (move == ttMove)
+        {
+            scores[i] = TT_MOVE_SCORE;
+        }
+        else if (theirs.test(move.getTo()))
+        {
+            // most valuable victim first, then least valuable attacker
+            scores[i] = CAPTURE_SCORE + evaluator.getValue(position.getTypeAt(move.getTo())) * 64 -
+                        evaluator.getValue(position.getTypeAt(move.getFrom()));
+        }
+        else if (move == killers[ply][0])
+        {
+            scores[i] = KILLER_SCORE;
+        }
+        else if (move == killers[ply][1])
+        {
+            scores[i] = KILLER_SCORE - 1;
+        }
+        else
+        {
+            scores[i] = history[(rules::indexOf(us) * squareCount + move.getFrom()) * squareCount + move.getTo()];
+        }
+    }
+}
+
+template <typename BB> bool Search<BB>::isRepetition() const noexcept
+{
+    rules::zobrist::Key key = keys.back();
+    // only positions with the same side to move can be equal
+    for (int i = static_cast<int>(keys.size()) - 3; i >= 0; i -= 2)
+    {
+        if (keys[i] == key)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename BB> bool Search<BB>::countNode()
+{
+    // only this thread writes the counter, so a plain load and store is enough and avoids a locked add
+    std::uint64_t count = nodes.load(std::memory_order_relaxed) + 1;
+    nodes.store(count, std::memory_order_relaxed);
+    if (count % CHECK_INTERVAL == 0)
+    {
+        if (limits.nodes != 0 && totalNodes() >= limits.nodes)
+        {
+            stopped.store(true, std::memory_order_relaxed);
+        }
+        if (limits.time.count() > 0 && std::chrono::steady_clock::now() - startTime >= limits.time)
+        {
+            stopped.store(true, std::memory_order_relaxed);
+        }
+    }
+    return stopped.load(std::memory_order_relaxed);
+}
+
+template <typename BB> void Search<BB>::makeMove(rules::BasicPosition<BB> &position, rules::Move move, int ply)
+{
+    rules::Color mover = position.getSideToMove();
+    position.makeMove(move, stack[ply].undo);
+    stack[ply + 1].balance = stack[ply].balance + evaluator.getMoveDelta(mover, move, stack[ply].undo);
+}
+
+template <typename BB> int Search<BB>::evaluate(const rules::BasicPosition<BB> &position, int ply) const noexcept
+{
+    return position.getSideToMove() == rules::Color::White ? stack[ply].balance : -stack[ply].balance;
+}
+
+template <typename BB> std::uint64_t Search<BB>::totalNodes() const noexcept
+{
+    std::uint64_t total = getNodes();
+    for (const Search *helper : helpers)
+    {
+        total += helper->getNodes();
+    }
+    return total;
+}
+
+#define INSTANTIATE(BB) template class Search<BB>;
+RULES_FOR_EACH_BITBOARD(INSTANTIATE)
+#undef INSTANTIATE
+} // namespace engine
@@ -0,0 +1,384 @@
+/**
+ * @file search.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains the Search class template and the types describing a search's limits and results
+ * @date 2026-10-17
+ */
+
+#ifndef ENGINE_SEARCH_HH
+#define ENGINE_SEARCH_HH
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <engine/evaluator.hh>
+#include <engine/transposition_table.hh>
+#include <functional>
+#include <rules/move.hh>
+#include <rules/position.hh>
+#include <rules/variant.hh>
+#include <rules/zobrist.hh>
+#include <vector>
+
+namespace engine
+{
+/**
+ * @brief The deepest a search can go, counting quiescence and extensions.
+ *
+ */
+constexpr int MAX_PLY = 128;
+/**
+ * @brief The score of delivering checkmate right now. Mate in `n` plies scores `MATE_SCORE - n`.
+ *
+ */
+constexpr int MATE_SCORE = 30000;
+/**
+ * @brief A score larger than any real score, used as the initial search window.
+ *
+ */
+constexpr int INFINITE_SCORE = 31000;
+
+/**
+ * @brief Check whether a score means a forced checkmate for either side.
+ *
+ * @param score the score
+ * @return true the score is a mate score
+ * @return false the score is an evaluation
+ */
+constexpr bool isMateScore(int score)
+{
+    return score >= MATE_SCORE - MAX_PLY || score <= -(MATE_SCORE - MAX_PLY);
+}
+
+/**
+ * @brief When a search should stop. The search stops at whichever limit is reached first.
+ *
+ */
+struct SearchLimits
+{
+    /**
+     * @brief The deepest iteration to search, in plies.
+     *
+     */
+    int depth = MAX_PLY - 1;
+    /**
+     * @brief The most nodes to search, or 0 for no limit.
+     *
+     */
+    std::uint64_t nodes = 0;
+    /**
+     * @brief The longest to search, or 0 for no limit.
+     *
+     */
+    std::chrono::milliseconds time{0};
+};
+
+/**
+ * @brief The outcome of a search, or of one iteration of it.
+ *
+ */
+struct SearchResult
+{
+    /**
+     * @brief The best move found, or the null move if the side to move has no legal moves.
+     *
+     */
+    rules::Move bestMove;
+    /**
+     * @brief The score of the position from the side to move's point of view, in centipawns or as a mate score.
+     *
+     */
+    int score = 0;
+    /**
+     * @brief The depth of the deepest completed iteration.
+     *
+     */
+    int depth = 0;
+    /**
+     * @brief The principal variation: the best line of play found, starting with bestMove.
+     *
+     */
+    std::vector<rules::Move> pv;
+    /**
+     * @brief The number of nodes searched.
+     *
+     */
+    std::uint64_t nodes = 0;
+    /**
+     * @brief How long the search took.
+     *
+     */
+    std::chrono::milliseconds time{0};
+};
+
+/**
+ * @brief A principal-variation alpha-beta search with iterative deepening, for any variant.
+ *
+ * The search deepens one ply per iteration until a limit is reached, and reports the result of the deepest completed
+ * iteration. It uses a transposition table (which can be shared with other searches), quiescence search of captures,
+ * and killer and history move ordering. A search is run from one thread at a time, but can be stopped from any
+ * thread.
+ *
+ * Several searches can work on the same position at once, sharing a table (see ParallelSearch). The one with thread
+ * index 0 is the main search, which owns the limits and reports progress; the others are helpers, which search until
+ * stopped and skip some depths so that the threads spread out across depths. Each search is aligned to a cache line
+ * so that one thread's killers and counters never share a line with another's.
+ *
+ * @tparam BB the bitboard type of the board
+ */
+template <typename BB> class alignas(64) Search
+{
+  public:
+    /**
+     * @brief Construct a search for a variant.
+     *
+     * @param variant the rules being played; must outlive the search
+     * @param table the transposition table to use; must outlive the search
+     * @param threadIndex 0 for a main search, or the index of a helper search among those on the same position
+     */
+    Search(const rules::BasicVariant<BB> &variant, TranspositionTable &table, int threadIndex = 0);
+
+    /**
+     * @brief Search a position for the best move. The search does not clear the stop flag itself, so that a stop
+     * requested before the thread running it gets to it is not lost; call clearStop() before starting each search.
+     *
+     * @param position the position
+     * @param limits when to stop
+     * @param gameHistory the keys of the positions played before `position` in the game, oldest first, so that
+     * repetitions of them are scored as draws
+     * @return SearchResult the result of the deepest completed iteration
+     */
+    SearchResult run(const rules::BasicPosition<BB> &position, const SearchLimits &limits,
+                     const std::vector<rules::zobrist::Key> &gameHistory = {});
+    /**
+     * @brief Stop a running search as soon as possible. Safe to call from any thread.
+     *
+     */
+    void stop() noexcept;
+    /**
+     * @brief Forget a stop requested before, so that the next run() searches until its limits.
+     *
+     */
+    void clearStop() noexcept;
+    /**
+     * @brief Forget the move ordering statistics kept from earlier runs, so that the next run searches as a new search
+     * would.
+     *
+     */
+    void clearHistory() noexcept;
+    /**
+     * @brief Set a function to call with the result of each completed iteration, e.g. to show the search's progress.
+     *
+     * @param callback the function
+     */
+    void setIterationCallback(std::function<void(const SearchResult &)> callback);
+    /**
+     * @brief Set the helper searches working on the same position, whose nodes count towards the node limit and the
+     * reported node count.
+     *
+     * @param helpers the helpers; must outlive the search
+     */
+    void setHelpers(std::vector<const Search *> helpers);
+    /**
+     * @brief Get the number of nodes this search has searched so far. Safe to call from any thread.
+     *
+     * @return std::uint64_t the number of nodes
+     */
+    std::uint64_t getNodes() const noexcept;
+
+  private:
+    /**
+     * @brief Search a position to a depth.
+     *
+     * @param position the position, which moves are made and unmade on in place; it is unchanged on return
+     * @param depth the remaining depth
+     * @param ply the distance from the root
+     * @param alpha the lower bound of the window
+     * @param beta the upper bound of the window
+     * @return int the score from the side to move's point of view
+     */
+    int negamax(rules::BasicPosition<BB> &position, int depth, int ply, int alpha, int beta);
+    /**
+     * @brief Search captures only, until the position is quiet, to avoid misjudging positions mid-exchange.
+     *
+     * @param position the position, which moves are made and unmade on in place; it is unchanged on return
+     * @param ply the distance from the root
+     * @param alpha the lower bound of the window
+     * @param beta the upper bound of the window
+     * @return int the score from the side to move's point of view
+     */
+    int quiesce(rules::BasicPosition<BB> &position, int ply, int alpha, int beta);
+    /**
+     * @brief Give each move a score for move ordering.
+     *
+     * @param position the position the moves are from
+     * @param moves the moves
+     * @param scores where to write each move's score
+     * @param ttMove the move from the transposition table, or the null move
+     * @param ply the distance from the root
+     */
+    void scoreMoves(const rules::BasicPosition<BB> &position, const rules::MoveList &moves, int *scores,
+                    rules::Move ttMove, int ply) const;
+    /**
+     * @brief Check whether the current position repeats an earlier one with the same side to move.
+     *
+     * @return true the position is a repetition
+     * @return false the position is new
+     */
+    bool isRepetition() const noexcept;
+    /**
+     * @brief Count a node, and check the limits every so often.
+     *
+     * @return true the search should stop
+     * @return false the search should continue
+     */
+    bool countNode();
+    /**
+     * @brief Count the nodes searched by this search and its helpers.
+     *
+     * @return std::uint64_t the number of nodes
+     */
+    std::uint64_t totalNodes() const noexcept;
+    /**
+     * @brief Play a move on the path from the root, recording how to take it back in the ply's stack entry.
+     *
+     * @param position the position at `ply`
+     * @param move the move
+     * @param ply the distance of `position` from the root
+     */
+    void makeMove(rules::BasicPosition<BB> &position, rules::Move move, int ply);
+    /**
+     * @brief Get the static evaluation of the position at a ply, kept up to date by makeMove().
+     *
+     * @param position the position at `ply`
+     * @param ply the distance of `position` from the root
+     * @return int the score from the side to move's point of view
+     */
+    int evaluate(const rules::BasicPosition<BB> &position, int ply) const noexcept;
+
+    /**
+     * @brief What the search keeps about each ply on the path from the root.
+     *
+     */
+    struct PlyState
+    {
+        /**
+         * @brief How to take back the move played from this ply.
+         *
+         */
+        rules::UndoInfo undo;
+        /**
+         * @brief The static evaluation of the position at this ply, from white's point of view.
+         *
+         */
+        int balance;
+    };
+    /**
+     * @brief The moves of a ply being searched and their ordering scores. Each is several kilobytes, so they are kept
+     * off the call stack, in moveStack.
+     *
+     */
+    struct PlyMoves
+    {
+        /**
+         * @brief The moves, ordered as they are searched.
+         *
+         */
+        rules::MoveList moves;
+        /**
+         * @brief The ordering score of each move.
+         *
+         */
+        std::array<int, rules::MoveList::CAPACITY> scores;
+    };
+
+    /**
+     * @brief The rules being played.
+     *
+     */
+    const rules::BasicVariant<BB> &variant;
+    /**
+     * @brief The transposition table.
+     *
+     */
+    TranspositionTable &table;
+    /**
+     * @brief The static evaluation.
+     *
+     */
+    Evaluator<BB> evaluator;
+    /**
+     * @brief 0 for a main search, or the index of a helper search.
+     *
+     */
+    int threadIndex;
+    /**
+     * @brief The helper searches working on the same position.
+     *
+     */
+    std::vector<const Search *> helpers;
+    /**
+     * @brief Called after each completed iteration, if set.
+     *
+     */
+    std::function<void(const SearchResult &)> iterationCallback;
+    /**
+     * @brief Set to stop the search.
+     *
+     */
+    std::atomic<bool> stopped;
+    /**
+     * @brief The limits of the running search.
+     *
+     */
+    SearchLimits limits;
+    /**
+     * @brief When the running search started.
+     *
+     */
+    std::chrono::steady_clock::time_point startTime;
+    /**
+     * @brief The number of nodes searched so far. Only written by the searching thread, but read by others.
+     *
+     */
+    std::atomic<std::uint64_t> nodes;
+    /**
+     * @brief The keys of the game's positions, followed by those on the path from the root to the current node.
+     *
+     */
+    std::vector<rules::zobrist::Key> keys;
+    /**
+     * @brief Two quiet moves per ply that recently caused a beta cutoff.
+     *
+     */
+    std::array<std::array<rules::Move, 2>, MAX_PLY> killers;
+    /**
+     * @brief How often each quiet move has caused a cutoff, weighted by depth, indexed by (color, from, to).
+     *
+     */
+    std::vector<int> history;
+    /**
+     * @brief The principal variation found at each ply, as a triangular table.
+     *
+     */
+    std::array<std::array<rules::Move, MAX_PLY>, MAX_PLY> pvTable;
+    /**
+     * @brief The length of the principal variation at each ply.
+     *
+     */
+    std::array<int, MAX_PLY> pvLength;
+    /**
+     * @brief The state of each ply on the path from the root to the current node.
+     *
+     */
+    std::array<PlyState, MAX_PLY + 1> stack;
+    /**
+     * @brief The moves of each ply on the path from the root to the current node, allocated once with the search.
+     *
+     */
+    std::vector<PlyMoves> moveStack;
+};
+} // namespace engine
+
+#endif // ENGINE_SEARCH_HH
@@ -0,0 +1,222 @@
+#include "transposition_table.hh"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace engine
+{
+/**
+ * @brief The number of bits used for an entry's generation.
+ *
+ */
+constexpr int GENERATION_BITS = 6;
+/**
+ * @brief A mask of the generation bits.
+ *
+ */
+constexpr std::uint8_t GENERATION_MASK = (1 << GENERATION_BITS) - 1;
+/**
+ * @brief The alignment used when backing the table with huge pages.
+ *
+ */
+constexpr std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+/**
+ * @brief The number of buckets sampled by hashfull().
+ *
+ */
+constexpr std::size_t HASHFULL_SAMPLE = 250;
+
+/**
+ * @brief Pack an entry's data into a word. From the low bits up: move (16), score (16), depth (8), bound (2) and
+ * generation (6). The top 16 bits are unused.
+ *
+ * @param data the data
+ * @param generation the generation it was stored in
+ * @return std::uint64_t the packed word
+ */
+static std::uint64_t pack(const TTData &data, std::uint8_t generation)
+{
+    return static_cast<std::uint64_t>(data.move.getBits()) |
+           static_cast<std::uint64_t>(static_cast<std::uint16_t>(data.score)) << 16 |
+           static_cast<std::uint64_t>(std::clamp(data.depth, 0, TranspositionTable::MAX_DEPTH)) << 32 |
+           static_cast<std::uint64_t>(data.bound) << 40 | static_cast<std::uint64_t>(generation) << 42;
+}
+
+/**
+ * @brief Unpack an entry's data from a word. See pack().
+ *
+ * @param word the packed word
+ * @return TTData the data
+ */
+static TTData unpack(std::uint64_t word)
+{
+    TTData data;
+    data.move = rules::Move::fromBits(static_cast<std::uint16_t>(word));
+    data.score = static_cast<std::int16_t>(word >> 16);
+    data.depth = static_cast<int>((word >> 32) & 0xff);
+    data.bound = static_cast<Bound>((word >> 40) & 0x3);
+    return data;
+}
+
+/**
+ * @brief Get the generation an entry was stored in.
+ *
+ * @param word the packed word
+ * @return std::uint8_t the generation
+ */
+static std::uint8_t generationOf(std::uint64_t word)
+{
+    return static_cast<std::uint8_t>((word >> 42) & GENERATION_MASK);
+}
+
+TranspositionTable::TranspositionTable(std::size_t megabytes, bool hugePages) : generation(0)
+{
+    std::size_t alignment = hugePages ? HUGE_PAGE_SIZE : alignof(Bucket);
+    bucketCount = std::max<std::size_t>(1, megabytes * 1024 * 1024 / sizeof(Bucket));
+    // aligned_alloc requires the size to be a multiple of the alignment
+    allocationSize = (bucketCount * sizeof(Bucket) + alignment - 1) / alignment * alignment;
+    void *memory = std::aligned_alloc(alignment, allocationSize);
+    if (memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+#ifdef __linux__
+    if (hugePages)
+    {
+        // only a hint; the table works the same if the kernel declines
+        madvise(memory, allocationSize, MADV_HUGEPAGE);
+    }
+#endif
+    buckets = new (memory) Bucket[bucketCount];
+    clear();
+}
+
+TranspositionTable::~TranspositionTable()
+{
+    std::free(buckets);
+}
+
+void TranspositionTable::clear(int threads)
+{
+    threads = std::max(1, threads);
+    auto clearRange = [this](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++)
+        {
+            for (Entry &entry : buckets[i].entries)
+            {
+                entry.keyXorData.store(0, std::memory_order_relaxed);
+                entry.data.store(0, std::memory_order_relaxed);
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    std::size_t chunk = (bucketCount + threads - 1) / threads;
+    for (int i = 1; i < threads; i++)
+    {
+        std::size_t begin = std::min(bucketCount, chunk * i);
+        std::size_t end = std::min(bucketCount, begin + chunk);
+        workers.emplace_back(clearRange, begin, end);
+    }
+    clearRange(0, std::min(bucketCount, chunk));
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+    generation.store(0, std::memory_order_relaxed);
+}
+
+void TranspositionTable::newSearch() noexcept
+{
+    generation.store((generation.load(std::memory_order_relaxed) + 1) & GENERATION_MASK, std::memory_order_relaxed);
+}
+
+TranspositionTable::Bucket &TranspositionTable::bucketFor(rules::zobrist::Key key) const noexcept
+{
+    // map the key onto [0, bucketCount) with a multiply instead of a modulo
+    __extension__ using Wide = unsigned __int128;
+    return buckets[static_cast<std::size_t>((static_cast<Wide>(key) * bucketCount) >> 64)];
+}
+
+bool TranspositionTable::probe(rules::zobrist::Key key, TTData &data) const noexcept
+{
+    Bucket &bucket = bucketFor(key);
+    for (Entry &entry : bucket.entries)
+    {
+        std::uint64_t word = entry.data.load(std::memory_order_relaxed);
+        if ((entry.keyXorData.load(std::memory_order_relaxed) ^ word) == key && word != 0)
+        {
+            data = unpack(word);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TranspositionTable::store(rules::zobrist::Key key, const TTData &data) noexcept
+{
+    Bucket &bucket = bucketFor(key);
+    std::uint8_t current = generation.load(std::memory_order_relaxed);
+    Entry *replace = nullptr;
+    int replaceWorth = 0;
+    std::uint64_t oldWord = 0;
+    for (Entry &entry : bucket.entries)
+    {
+        std::uint64_t word = entry.data.load(std::memory_order_relaxed);
+        if ((entry.keyXorData.load(std::memory_order_relaxed) ^ word) == key)
+        {
+            replace = &entry;
+            oldWord = word;
+            break;
+        }
+        // prefer to replace shallow entries, and entries from earlier searches
+        int age = (current - generationOf(word)) & GENERATION_MASK;
+        int worth = static_cast<int>((word >> 32) & 0xff) - 8 * age;
+        if (replace == nullptr || worth < replaceWorth)
+        {
+            replace = &entry;
+            replaceWorth = worth;
+        }
+    }
+
+    TTData toStore = data;
+    if (toStore.move.isNull() && oldWord != 0)
+    {
+        toStore.move = unpack(oldWord).move;
+    }
+    std::uint64_t word = pack(toStore, current);
+    replace->data.store(word, std::memory_order_relaxed);
+    replace->keyXorData.store(key ^ word, std::memory_order_relaxed);
+}
+
+void TranspositionTable::prefetch(rules::zobrist::Key key) const noexcept
+{
+    __builtin_prefetch(&bucketFor(key));
+}
+
+int TranspositionTable::hashfull() const noexcept
+{
+    std::size_t sample = std::min(bucketCount, HASHFULL_SAMPLE);
+    std::uint8_t current = generation.load(std::memory_order_relaxed);
+    int used = 0;
+    for (std::size_t i = 0; i < sample; i++)
+    {
+        for (const Entry &entry : buckets[i].entries)
+        {
+            std::uint64_t word = entry.data.load(std::memory_order_relaxed);
+            used += word != 0 && generationOf(word) == current ? 1 : 0;
+        }
+    }
+    return static_cast<int>(used * 1000 / (sample * BUCKET_SIZE));
+}
+
+std::size_t TranspositionTable::getSize() const noexcept
+{
+    return bucketCount * sizeof(Bucket);
+}
+} // namespace engine
@@ -0,0 +1,230 @@
+/**
+ * @file transposition_table.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains the TranspositionTable class
+ * @date 2026-10-17
+ */
+
+#ifndef ENGINE_TRANSPOSITION_TABLE_HH
+#define ENGINE_TRANSPOSITION_TABLE_HH
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <rules/move.hh>
+#include <rules/zobrist.hh>
+
+/**
+ * @namespace engine
+ * @brief Contains the game-playing engine: searching positions for the best move, and the tables that support it.
+ * Like rules, nothing in this namespace depends on SDL.
+ *
+ */
+namespace engine
+{
+/**
+ * @brief How a stored score relates to the position's true score.
+ *
+ */
+enum class Bound : std::uint8_t
+{
+    /**
+     * @brief The score is meaningless; only the move is useful.
+     *
+     */
+    None,
+    /**
+     * @brief The true score is at most the stored score (the search failed low).
+     *
+     */
+    Upper,
+    /**
+     * @brief The true score is at least the stored score (the search failed high).
+     *
+     */
+    Lower,
+    /**
+     * @brief The stored score is the true score at the stored depth.
+     *
+     */
+    Exact
+};
+
+/**
+ * @brief What the table knows about a position.
+ *
+ */
+struct TTData
+{
+    /**
+     * @brief The best move found, or the null move.
+     *
+     */
+    rules::Move move;
+    /**
+     * @brief The score of the position from the side to move's point of view.
+     *
+     */
+    int score;
+    /**
+     * @brief The depth the position was searched to.
+     *
+     */
+    int depth;
+    /**
+     * @brief How `score` relates to the true score.
+     *
+     */
+    Bound bound;
+};
+
+/**
+ * @brief A fixed-size hash table of search results, shared by every search thread without locks.
+ *
+ * Each entry is two 64-bit words: the packed data, and the position's key XORed with the data. A reader accepts an
+ * entry only if XORing the two words gives back its key, so an entry torn by two threads writing at once reads as a
+ * miss instead of as wrong data. Entries are grouped into buckets the size of a cache line, so a probe touches one
+ * line.
+ *
+ */
+class TranspositionTable
+{
+  public:
+    /**
+     * @brief The number of entries in a bucket.
+     *
+     */
+    static constexpr int BUCKET_SIZE = 4;
+    /**
+     * @brief The highest depth that can be stored.
+     *
+     */
+    static constexpr int MAX_DEPTH = 255;
+
+    /**
+     * @brief Allocate an empty table. This is the only allocation the table makes.
+     *
+     * @param megabytes the size of the table in MiB; the table holds as many buckets as fit
+     * @param hugePages whether to ask the OS to back the table with huge pages (Linux only; ignored elsewhere)
+     * @throw std::bad_alloc if the table cannot be allocated
+     */
+    TranspositionTable(std::size_t megabytes, bool hugePages = false);
+    ~TranspositionTable();
+
+    TranspositionTable(const TranspositionTable &) = delete;
+    TranspositionTable &operator=(const TranspositionTable &) = delete;
+
+    /**
+     * @brief Erase every entry. Must not be called while a search is running.
+     *
+     * @param threads the number of threads to clear the table with, which helps for tables of many gigabytes
+     */
+    void clear(int threads = 1);
+    /**
+     * @brief Start a new search. Entries from earlier searches are replaced before entries from this one. Call this
+     * once per search, however many threads the search uses.
+     *
+     */
+    void newSearch() noexcept;
+
+    /**
+     * @brief Look a position up.
+     *
+     * @param key the position's key
+     * @param data where to write what the table knows, if anything
+     * @return true the position was found and `data` was written
+     * @return false the position was not found
+     */
+    bool probe(rules::zobrist::Key key, TTData &data) const noexcept;
+    /**
+     * @brief Store what a search found out about a position, replacing the least valuable entry in its bucket.
+     *
+     * @param key the position's key
+     * @param data what the search found; a null move keeps the move already stored for the position, if any
+     */
+    void store(rules::zobrist::Key key, const TTData &data) noexcept;
+    /**
+     * @brief Hint to the CPU that a position will be probed soon, so its bucket can be fetched in the meantime.
+     *
+     * @param key the position's key
+     */
+    void prefetch(rules::zobrist::Key key) const noexcept;
+
+    /**
+     * @brief Estimate how full the table is with entries from the current search, by sampling its first buckets.
+     *
+     * @return int the fullness in permille
+     */
+    int hashfull() const noexcept;
+    /**
+     * @brief Get the size of the table.
+     *
+     * @return std::size_t the size in bytes
+     */
+    std::size_t getSize() const noexcept;
+
+  private:
+    /**
+     * @brief One entry, stored as two words so that it can be read and written without locks.
+     *
+     */
+    struct Entry
+    {
+        /**
+         * @brief The position's key XORed with `data`.
+         *
+         */
+        std::atomic<std::uint64_t> keyXorData;
+        /**
+         * @brief The packed TTData and the search generation it was stored in.
+         *
+         */
+        std::atomic<std::uint64_t> data;
+    };
+
+    /**
+     * @brief A cache line of entries. A position can only be stored in the bucket its key maps to.
+     *
+     */
+    struct alignas(64) Bucket
+    {
+        /**
+         * @brief The entries.
+         *
+         */
+        Entry entries[BUCKET_SIZE];
+    };
+
+    /**
+     * @brief Find the bucket a key maps to.
+     *
+     * @param key the key
+     * @return Bucket& the bucket
+     */
+    Bucket &bucketFor(rules::zobrist::Key key) const noexcept;
+
+    /**
+     * @brief The buckets.
+     *
+     */
+    Bucket *buckets;
+    /**
+     * @brief The number of buckets.
+     *
+     */
+    std::size_t bucketCount;
+    /**
+     * @brief The number of bytes allocated for `buckets`.
+     *
+     */
+    std::size_t allocationSize;
+    /**
+     * @brief The current search generation, which ages out entries from earlier searches. Atomic because a search
+     * may start while helper threads are still storing entries.
+     *
+     */
+    std::atomic<std::uint8_t> generation;
+};
+} // namespace engine
+
+#endif // ENGINE_TRANSPOSITION_TABLE_HH
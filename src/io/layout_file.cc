@@ -0,0 +1,275 @@
+#include "layout_file.hh"
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <io/piece_definition.hh>
+#include <rules/move_generator.hh>
+#include <stdexcept>
+#include <util/util.hh>
+
+namespace io
+{
+/**
+ * @brief The state we're in while parsing a layout file.
+ *
+ */
+enum class LayoutFileState
+{
+    Size,
+    Pieces,
+    Board,
+    SideToMove,
+    Done
+};
+
+/**
+ * @brief Split a line into its comma-separated fields, trimming each one.
+ *
+ * @param line the line
+ * @return std::vector<std::string> the fields
+ */
+static std::vector<std::string> splitFields(const std::string &line)
+{
+    std::vector<std::string> fields;
+    std::string::size_type start = 0;
+    while (true)
+    {
+        auto comma = line.find(',', start);
+        if (comma == std::string::npos)
+        {
+            fields.push_back(util::trim(line.substr(start)));
+            return fields;
+        }
+        fields.push_back(util::trim(line.substr(start, comma - start)));
+        start = comma + 1;
+    }
+}
+
+Layout readLayoutFile(std::string_view fileName)
+{
+    std::ifstream file(fileName.data());
+    if (!file)
+    {
+        throw std::runtime_error(util::concat("reading layout file ", fileName, ": could not open file"));
+    }
+    std::filesystem::path directory = std::filesystem::path(fileName).parent_path();
+    Layout layout{0, 0, {}, {}, rules::Color::White};
+    LayoutFileState state = LayoutFileState::Size;
+    std::string line;
+    int lineNum = 0;
+    while (std::getline(file, line))
+    {
+        lineNum += 1;
+        std::string trimmed = util::trim(line);
+        // ignore blank lines and comments
+        if (trimmed.length() == 0 || trimmed[0] == '#')
+        {
+            continue;
+        }
+        switch (state)
+        {
+        case LayoutFileState::Size: {
+            std::vector<std::string> fields = splitFields(trimmed);
+            if (fields.size() != 2)
+            {
+                throw std::runtime_error(util::concat("reading layout file ", fileName, ": line ", lineNum,
+                                                      ": invalid format for board size '", trimmed, "'"));
+            }
+            try
+            {
+                layout.width = util::parseInt<int>(fields[0]);
+                layout.height = util::parseInt<int>(fields[1]);
+            }
+            catch (std::runtime_error &e)
+            {
+                throw std::runtime_error(
+                    util::concat("reading layout file ", fileName, ": line ", lineNum, ": ", e.what()));
+            }
+            state = LayoutFileState::Pieces;
+            break;
+        }
+        case LayoutFileState::Pieces: {
+            if (trimmed == "END")
+            {
+                state = LayoutFileState::Board;
+                break;
+            }
+            std::vector<std::string> fields = splitFields(trimmed);
+            bool crowned = fields.size() == 3 && fields[2] == "crown";
+            if ((fields.size() != 2 && !crowned) || fields[0].length() != 1 ||
+                std::isupper(static_cast<unsigned char>(fields[0][0])) == 0)
+            {
+                throw std::runtime_error(util::concat("reading layout file ", fileName, ": line ", lineNum,
+                                                      ": invalid format for piece '", trimmed, "'"));
+            }
+            for (const LayoutPiece &piece : layout.pieces)
+            {
+                if (piece.symbol == fields[0][0])
+                {
+                    throw std::runtime_error(util::concat("reading layout file ", fileName, ": line ", lineNum,
+                                                          ": symbol '", piece.symbol, "' is used twice"));
+                }
+            }
+            layout.pieces.push_back(LayoutPiece{fields[0][0], (directory / fields[1]).string(), crowned});
+            break;
+        }
+        case LayoutFileState::Board: {
+            if (trimmed == "END")
+            {
+                if (static_cast<int>(layout.rows.size()) != layout.height)
+                {
+                    throw std::runtime_error(util::concat("reading layout file ", fileName, ": line ", lineNum,
+                                                          ": expected ", layout.height, " rows, got ",
+                                                          layout.rows.size()));
+                }
+                state = LayoutFileState::SideToMove;
+                break;
+            }
+            if (static_cast<int>(trimmed.length()) != layout.width)
+            {
+                throw std::runtime_error(util::concat("reading layout file ", fileName, ": line ", lineNum,
+                                                      ": expected ", layout.width, " squares, got ",
+                                                      trimmed.length()));
+            }
+            for (char c : trimmed)
+            {
+                bool known = c == '.' || c == '-';
+                for (const LayoutPiece &piece : layout.pieces)
+                {
+                    known = known || std::toupper(static_cast<unsigned char>(c)) == piece.symbol;
+                }
+                if (!known)
+                {
+                    throw std::runtime_error(util::concat("reading layout file ", fileName, ": line ", lineNum,
+                                                          ": unknown square '", c, "'"));
+                }
+            }
+            layout.rows.push_back(trimmed);
+            break;
+        }
+        case LayoutFileState::SideToMove: {
+            if (trimmed == "white")
+            {
+                layout.sideToMove = rules::Color::White;
+            }
+            else if (trimmed == "black")
+            {
+                layout.sideToMove = rules::Color::Black;
+            }
+            else
+            {
+                throw std::runtime_error(util::concat("reading layout file ", fileName, ": line ", lineNum,
+                                                      ": expected 'white' or 'black', got '", trimmed, "'"));
+            }
+            state = LayoutFileState::Done;
+            break;
+        }
+        case LayoutFileState::Done: {
+            throw std::runtime_error(util::concat("reading layout file ", fileName, ": line ", lineNum,
+                                                  ": Unexpected line '", trimmed, "', expected EOF"));
+        }
+        }
+    }
+    if (state != LayoutFileState::Done)
+    {
+        throw std::runtime_error(util::concat("reading layout file ", fileName, ": unexpected end of file"));
+    }
+    return layout;
+}
+
+template <typename BB> rules::BasicBoardGeometry<BB> createGeometry(const Layout &layout)
+{
+    rules::BasicBoardGeometry<BB> geometry(layout.width, layout.height);
+    for (int y = 0; y < layout.height; y++)
+    {
+        for (int x = 0; x < layout.width; x++)
+        {
+            if (layout.rows[y][x] == '-')
+            {
+                geometry.setEnabled(geometry.squareAt(x, y), false);
+            }
+        }
+    }
+    return geometry;
+}
+
+template <typename BB> rules::BasicVariant<BB> createVariant(const Layout &layout)
+{
+    rules::BasicVariant<BB> variant(createGeometry<BB>(layout));
+    for (const LayoutPiece &piece : layout.pieces)
+    {
+        variant.addPieceType(parsePieceFile(piece.fileName).moves);
+    }
+    return variant;
+}
+
+template <typename BB>
+rules::BasicPosition<BB> createPosition(const Layout &layout, const rules::BasicVariant<BB> &variant)
+{
+    rules::BasicPosition<BB> position;
+    for (int y = 0; y < layout.height; y++)
+    {
+        for (int x = 0; x < layout.width; x++)
+        {
+            char c = layout.rows[y][x];
+            if (c == '.' || c == '-')
+            {
+                continue;
+            }
+            rules::Color color = std::isupper(static_cast<unsigned char>(c)) != 0 ? rules::Color::White
+                                                                                   : rules::Color::Black;
+            rules::Square sq = y * layout.width + x;
+            for (rules::PieceType type = 0; type < static_cast<rules::PieceType>(layout.pieces.size()); type++)
+            {
+                const LayoutPiece &piece = layout.pieces[type];
+                if (piece.symbol != std::toupper(static_cast<unsigned char>(c)))
+                {
+                    continue;
+                }
+                position.place(color, type, sq);
+                if (piece.crowned)
+                {
+                    if (position.getCrown(color) != rules::NO_SQUARE)
+                    {
+                        throw std::runtime_error(util::concat("creating position: more than one crowned piece for ",
+                                                              color == rules::Color::White ? "white" : "black"));
+                    }
+                    position.setCrown(color, sq);
+                }
+            }
+        }
+    }
+    for (rules::PieceType type = 0; type < static_cast<rules::PieceType>(layout.pieces.size()); type++)
+    {
+        if (!layout.pieces[type].crowned)
+        {
+            continue;
+        }
+        for (rules::Color color : {rules::Color::White, rules::Color::Black})
+        {
+            if (position.getCrown(color) == rules::NO_SQUARE)
+            {
+                throw std::runtime_error(util::concat("creating position: no crowned '", layout.pieces[type].symbol,
+                                                      "' for ", color == rules::Color::White ? "white" : "black"));
+            }
+        }
+    }
+    position.setSideToMove(layout.sideToMove);
+    // move lists have a fixed capacity, so a layout that could overflow one is rejected before it is searched
+    int maxMoves = rules::maxPseudoLegalMoves(variant, position);
+    if (maxMoves > rules::MoveList::CAPACITY)
+    {
+        throw std::runtime_error(util::concat("creating position: a side could have up to ", maxMoves,
+                                              " moves at once, more than the ", rules::MoveList::CAPACITY,
+                                              " a move list holds"));
+    }
+    return position;
+}
+
+#define INSTANTIATE(BB)                                                                                               \
+    template rules::BasicBoardGeometry<BB> createGeometry(const Layout &);                                            \
+    template rules::BasicVariant<BB> createVariant(const Layout &);                                                   \
+    template rules::BasicPosition<BB> createPosition(const Layout &, const rules::BasicVariant<BB> &);
+RULES_FOR_EACH_BITBOARD(INSTANTIATE)
+#undef INSTANTIATE
+} // namespace io
@@ -0,0 +1,132 @@
+/**
+ * @file layout_file.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains functions involving reading of .layout files
+ * @date 2026-10-17
+ */
+
+#ifndef IO_LAYOUT_FILE_HH
+#define IO_LAYOUT_FILE_HH
+
+#include <rules/position.hh>
+#include <rules/types.hh>
+#include <rules/variant.hh>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace io
+{
+/**
+ * @brief A piece type used by a layout.
+ *
+ */
+struct LayoutPiece
+{
+    /**
+     * @brief The uppercase letter standing for the white version of the piece on the board. The lowercase letter
+     * stands for the black version.
+     *
+     */
+    char symbol;
+    /**
+     * @brief The path of the piece file defining the piece.
+     *
+     */
+    std::string fileName;
+    /**
+     * @brief Whether each side's piece of this type wears its crown.
+     *
+     */
+    bool crowned;
+};
+
+/**
+ * @brief The contents of a layout file: a board, the pieces used on it, and where they start.
+ *
+ * A layout file has four sections, each of which may be preceded by comment lines starting with '#':
+ *
+ * 1. The board size as `width, height`.
+ * 2. One line per piece type as `symbol, piece file` or `symbol, piece file, crown`, followed by `END`. Piece files
+ *    are found relative to the layout file.
+ * 3. One line per row of the board, top row first, followed by `END`. Each character is a square: an uppercase
+ *    symbol for a white piece, a lowercase symbol for a black piece, `.` for an empty square, or `-` for a square
+ *    that is not on the board. White moves up the board.
+ * 4. The side to move first, `white` or `black`.
+ *
+ */
+struct Layout
+{
+    /**
+     * @brief The number of columns.
+     *
+     */
+    int width;
+    /**
+     * @brief The number of rows.
+     *
+     */
+    int height;
+    /**
+     * @brief The piece types, in order of their PieceType IDs.
+     *
+     */
+    std::vector<LayoutPiece> pieces;
+    /**
+     * @brief The rows of the board, top row first.
+     *
+     */
+    std::vector<std::string> rows;
+    /**
+     * @brief The side to move first.
+     *
+     */
+    rules::Color sideToMove;
+};
+
+/**
+ * @brief Read a layout file.
+ *
+ * @param fileName the layout file name
+ * @return Layout the layout
+ * @throw std::runtime_error if the file is malformed
+ */
+Layout readLayoutFile(std::string_view fileName);
+
+/**
+ * @brief Create the board a layout is played on, with its '-' squares disabled.
+ *
+ * @tparam BB the bitboard type, which must hold every square of the layout's board
+ * @param layout the layout
+ * @return rules::BasicBoardGeometry<BB> the board
+ * @throw std::invalid_argument if the board is too large for BB
+ */
+template <typename BB> rules::BasicBoardGeometry<BB> createGeometry(const Layout &layout);
+
+/**
+ * @brief Create the variant a layout is played with, reading each of its piece files. See rules::withBitboardFor()
+ * for choosing the bitboard type.
+ *
+ * @tparam BB the bitboard type, which must hold every square of the layout's board
+ * @param layout the layout
+ * @return rules::BasicVariant<BB> the variant, with piece types in the layout's order
+ * @throw std::runtime_error if a piece file is malformed
+ * @throw std::invalid_argument if the board is too large for BB
+ */
+template <typename BB> rules::BasicVariant<BB> createVariant(const Layout &layout);
+
+/**
+ * @brief Create the starting position of a layout.
+ *
+ * @tparam BB the bitboard type, which must hold every square of the layout's board
+ * @param layout the layout
+ * @param variant the layout's variant, from createVariant()
+ * @return rules::BasicPosition<BB> the position
+ * @throw std::runtime_error if a crowned piece type does not appear exactly once per side, or if a side could have
+ * more moves at once than a rules::MoveList holds
+ */
+template <typename BB>
+rules::BasicPosition<BB> createPosition(const Layout &layout, const rules::BasicVariant<BB> &variant);
+} // namespace io
+
+#endif // IO_LAYOUT_FILE_HH
@@ -0,0 +1,206 @@
+#include "piece_definition.hh"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <io/tokenizer.hh>
+#include <rules/bitboard.hh>
+#include <stdexcept>
+#include <string>
+#include <util/mapped_file.hh>
+#include <util/util.hh>
+
+namespace io
+{
+/**
+ * @brief The state we're in while parsing a piece file.
+ *
+ */
+enum class PieceFileState
+{
+    PieceName,
+    ValidMoves,
+    WhiteFileName,
+    BlackFileName,
+    Done
+};
+
+/**
+ * @brief The most comma-separated fields a move can have: dx, dy, a range and modifiers.
+ *
+ */
+static constexpr std::size_t MAX_MOVE_FIELDS = 4;
+
+/**
+ * @brief Parse a move line of a piece file.
+ *
+ * @param tokens the tokenizer, on the move's line
+ * @return rules::Offset the move
+ * @throw std::runtime_error if the move is malformed
+ */
+static rules::Offset parseMove(const Tokenizer &tokens)
+{
+    std::string_view line = tokens.getLine();
+    std::size_t fieldCount = std::count(line.begin(), line.end(), ',') + 1;
+    if (fieldCount < 2 || fieldCount > MAX_MOVE_FIELDS)
+    {
+        throw tokens.error(line, util::concat("invalid format for move '", line, "'"));
+    }
+    std::array<std::string_view, MAX_MOVE_FIELDS> fields;
+    std::string_view rest = line;
+    for (std::size_t i = 0; i < fieldCount; i++)
+    {
+        fields[i] = nextToken(rest, ',');
+    }
+    // a range is '*' or a number; anything else in the third field is the modifiers
+    bool hasRange = fieldCount == 4;
+    if (fieldCount == 3)
+    {
+        hasRange = fields[2] == "*" || fields[2].find_first_of("-0123456789") == 0;
+    }
+    bool hasModifiers = fieldCount == 4 || (fieldCount == 3 && !hasRange);
+
+    rules::Offset move{tokens.parseInt(fields[0]), tokens.parseInt(fields[1])};
+    for (int i = 0; i < 2; i++)
+    {
+        int delta = i == 0 ? move.dx : move.dy;
+        if (delta <= -rules::MAX_BOARD_SIDE || delta >= rules::MAX_BOARD_SIDE)
+        {
+            throw tokens.error(fields[i], util::concat("offset must be less than ", rules::MAX_BOARD_SIDE,
+                                                       " squares in each direction, got ", delta));
+        }
+    }
+
+    // a rider's range: '*' to ride to the edge of the board, or the most times to repeat the move
+    if (hasRange)
+    {
+        if (fields[2] == "*")
+        {
+            move.range = rules::Offset::UNLIMITED;
+        }
+        else
+        {
+            move.range = tokens.parseInt(fields[2]);
+            if (move.range < 1)
+            {
+                throw tokens.error(fields[2], util::concat("range must be at least 1, got ", move.range));
+            }
+        }
+    }
+
+    // the modifiers: words separated by spaces
+    if (hasModifiers)
+    {
+        std::string_view words = fields[fieldCount - 1];
+        for (std::string_view word = nextWord(words); !word.empty(); word = nextWord(words))
+        {
+            if (word == "hop")
+            {
+                move.hop = true;
+            }
+            else if (word == "lame")
+            {
+                move.lame = true;
+            }
+            else if (word == "move")
+            {
+                move.capture = false;
+            }
+            else if (word == "capture")
+            {
+                move.quiet = false;
+            }
+            else
+            {
+                throw tokens.error(word, util::concat("unknown move modifier '", word, "'"));
+            }
+        }
+    }
+    // the offsets and range were checked above, where their fields can be pointed at
+    if (const char *error = checkMove(move))
+    {
+        throw tokens.error(line, error);
+    }
+    return move;
+}
+
+const char *checkMove(const rules::Offset &move) noexcept
+{
+    // bounding the offsets keeps the board arithmetic on them from overflowing
+    if (move.dx <= -rules::MAX_BOARD_SIDE || move.dx >= rules::MAX_BOARD_SIDE || move.dy <= -rules::MAX_BOARD_SIDE ||
+        move.dy >= rules::MAX_BOARD_SIDE)
+    {
+        return "an offset is too large for any board";
+    }
+    if (move.range < 1)
+    {
+        return "range must be at least 1";
+    }
+    if (!move.quiet && !move.capture)
+    {
+        return "a move cannot be both 'move' and 'capture'";
+    }
+    if (move.hop && move.range == 1)
+    {
+        return "a 'hop' move needs a range";
+    }
+    if (move.lame && move.range != 1)
+    {
+        return "a 'lame' move cannot have a range";
+    }
+    if (move.lame && std::abs(move.dx) < 2 && std::abs(move.dy) < 2)
+    {
+        return "a 'lame' move must go at least two squares along some axis";
+    }
+    return nullptr;
+}
+
+PieceDefinition parsePieceFile(std::string_view fileName)
+{
+    util::MappedFile file(fileName);
+    return parsePieceDefinition(std::string_view(reinterpret_cast<const char *>(file.data()), file.size()), fileName);
+}
+
+PieceDefinition parsePieceDefinition(std::string_view text, std::string_view fileName)
+{
+    Tokenizer tokens(text, util::concat("piece file ", fileName));
+    PieceDefinition definition;
+    PieceFileState state = PieceFileState::PieceName;
+    while (tokens.nextLine())
+    {
+        std::string_view line = tokens.getLine();
+        switch (state)
+        {
+        case PieceFileState::PieceName: {
+            definition.name = line;
+            state = PieceFileState::ValidMoves;
+            break;
+        }
+        case PieceFileState::ValidMoves: {
+            if (line == "END")
+            {
+                state = PieceFileState::WhiteFileName;
+            }
+            else
+            {
+                definition.moves.push_back(parseMove(tokens));
+            }
+            break;
+        }
+        case PieceFileState::WhiteFileName: {
+            definition.whiteFileName = line;
+            state = PieceFileState::BlackFileName;
+            break;
+        }
+        case PieceFileState::BlackFileName: {
+            definition.blackFileName = line;
+            state = PieceFileState::Done;
+            break;
+        }
+        case PieceFileState::Done: {
+            throw tokens.error(line, util::concat("unexpected line '", line, "', expected EOF"));
+        }
+        }
+    }
+    return definition;
+}
+} // namespace io
@@ -0,0 +1,94 @@
+/**
+ * @file piece_definition.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains functions for parsing .piece files without loading their images
+ * @date 2026-10-17
+ */
+
+#ifndef IO_PIECE_DEFINITION_HH
+#define IO_PIECE_DEFINITION_HH
+
+#include <rules/types.hh>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace io
+{
+/**
+ * @brief The contents of a piece file. Images are referred to by file name only, so a definition can be read
+ * without SDL.
+ *
+ * A piece file has four sections, each of which may be preceded by comment lines starting with '#':
+ *
+ * 1. The piece's name.
+ * 2. One line per move, followed by `END`. A leaper's move is `dx, dy`, relative to the piece's square: positive dy
+ *    is forward and negative dx is to the piece's left. dx and dy must each be less than rules::MAX_BOARD_SIDE in
+ *    size. A rider's move is `dx, dy, *` to repeat the move in a
+ *    straight line up to the edge of the board, or `dx, dy, n` to repeat it at most n times; either way it stops at
+ *    the first piece in its way, which it may capture. For example, a rook is `0, 1, *`, `1, 0, *`, `0, -1, *` and
+ *    `-1, 0, *`, and a nightrider rides the eight knight moves.
+ *
+ *    A move may end with modifiers, separated by spaces: `hop` makes a rider's move a hopper's, which must jump over
+ *    exactly one piece before it may land, going on like a rider from there; `lame` makes a leaper's move blockable
+ *    by a piece on the square one step toward its target; `move` keeps a move from capturing, and `capture` lets it
+ *    only capture. For example, a xiangqi horse is `1, 2, lame` and the other seven knight moves like it, and a
+ *    cannon is `0, 1, *, move` and `0, 1, *, hop capture` in each of the four directions.
+ * 3. The file name of the white version's image.
+ * 4. The file name of the black version's image.
+ *
+ */
+struct PieceDefinition
+{
+    /**
+     * @brief The piece's name.
+     *
+     */
+    std::string name;
+    /**
+     * @brief The piece's moves, relative to its square.
+     *
+     */
+    std::vector<rules::Offset> moves;
+    /**
+     * @brief The file name of the white version's image.
+     *
+     */
+    std::string whiteFileName;
+    /**
+     * @brief The file name of the black version's image.
+     *
+     */
+    std::string blackFileName;
+};
+
+/**
+ * @brief Parse a piece file. The file is mapped into memory rather than read.
+ *
+ * @param fileName the piece file name
+ * @return PieceDefinition the piece's definition
+ * @throw std::runtime_error if the file cannot be mapped or is malformed
+ */
+PieceDefinition parsePieceFile(std::string_view fileName);
+/**
+ * @brief Parse the contents of a piece file that are already in memory. Lines are parsed in place; only the
+ * definition's own strings and moves are allocated.
+ *
+ * @param text the contents of the file
+ * @param fileName the piece file name, for error messages
+ * @return PieceDefinition the piece's definition
+ * @throw std::runtime_error if the contents are malformed, naming the line and column
+ */
+PieceDefinition parsePieceDefinition(std::string_view text, std::string_view fileName);
+
+/**
+ * @brief Check that a move follows the rules of piece files, whatever it was read from: its offsets are in bounds, its
+ * range is at least 1, and its modifiers can be combined.
+ *
+ * @param move the move
+ * @return const char* why the move is invalid, or null if it is valid
+ */
+const char *checkMove(const rules::Offset &move) noexcept;
+} // namespace io
+
+#endif // IO_PIECE_DEFINITION_HH
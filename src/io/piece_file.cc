@@ -1,123 +1,45 @@
 #include "piece_file.hh"
 #include <chess/piece_factory.hh>
-#include <fstream>
-#include <sdl_wrapper/colors.hh>
-#include <sdl_wrapper/primitives/point.hh>
+#include <filesystem>
+#include <io/piece_definition.hh>
+#include <optional>
 #include <sdl_wrapper/render/texture.hh>
-#include <string>
+#include <stdexcept>
 #include <util/util.hh>
 
 namespace io
 {
+chess::PieceFactory readPieceFile(sdl::image::Context &imgContext, std::string_view fileName)
+{
+    PieceDefinition definition = parsePieceFile(fileName);
+    // load images, which are found relative to the piece file
+    std::filesystem::path directory = std::filesystem::path(fileName).parent_path();
+    auto whiteSurface = imgContext.load((directory / definition.whiteFileName).string());
+    auto blackSurface = imgContext.load((directory / definition.blackFileName).string());
+    return chess::PieceFactory(std::move(definition.moves), std::move(whiteSurface), std::move(blackSurface));
+}
+
 /**
- * @brief The state we're in while parsing a piece file.
+ * @brief Create a surface over a packed image's pixels, without copying them.
  *
+ * @param image the image
+ * @return sdl::surface::Surface the surface
  */
-enum class PieceFileState
+static sdl::surface::Surface viewImage(PieceImageView image)
 {
-    PieceName,
-    ValidMoves,
-    WhiteFileName,
-    BlackFileName,
-    Done
-};
-chess::PieceFactory readPieceFile(sdl::image::Context &imgContext, std::string_view fileName)
+    // SDL only reads the pixels of a surface that is not drawn on, so the read-only mapping is never written to
+    return sdl::surface::Surface(const_cast<unsigned char *>(image.pixels), image.width, image.height,
+                                 PACKED_PIXEL_SIZE * 8, image.width * PACKED_PIXEL_SIZE, SDL_PIXELFORMAT_RGBA32);
+}
+
+chess::PieceFactory readPackedPiece(const PiecePack &pack, std::string_view key)
 {
-    std::ifstream file(fileName.data());
-    std::string line;
-    std::set<sdl::primitives::Point> validMoves;
-    std::string whiteFile;
-    std::string blackFile;
-    std::string pieceName;
-    PieceFileState state = PieceFileState::PieceName;
-    int lineNum = 1;
-    while (std::getline(file, line))
+    std::optional<int> index = pack.find(key);
+    if (!index)
     {
-        // ignore blank lines
-        if (line.length() == 0 || util::trim(line).length() == 0)
-        {
-            continue;
-        }
-        // comments
-        if (line[0] == '#')
-        {
-            continue;
-        }
-        switch (state)
-        {
-        case PieceFileState::PieceName: {
-            pieceName = line;
-            state = PieceFileState::ValidMoves;
-            break;
-        }
-        case PieceFileState::ValidMoves: {
-            if (util::trim(line) == "END")
-            {
-                state = PieceFileState::WhiteFileName;
-            }
-            else
-            {
-                auto comma = line.find(',');
-                if (comma == std::string::npos)
-                {
-                    throw std::runtime_error(util::concat("reading piece file ", fileName, ": line ", lineNum,
-                                                          ": invalid format for move '", line, "'\n"));
-                }
-                // string representation of x coordinate
-                std::string xCoord = util::trim(line.substr(0, comma));
-                // string representation of y coordinate
-                std::string yCoord = util::trim(line.substr(comma + 1, line.length()));
-
-                // this initial value is never read if an exception is not thrown
-
-                int x = 0;
-                int y = 0;
-
-                // parse coordinates to integers
-                try
-                {
-                    x = util::parseInt(xCoord);
-                }
-                catch (std::runtime_error &e)
-                {
-                    throw std::runtime_error(
-                        util::concat("reading piece file ", fileName, ": line ", lineNum, ": ", e.what()));
-                }
-                try
-                {
-                    y = util::parseInt(yCoord);
-                }
-                catch (std::runtime_error &e)
-                {
-                    throw std::runtime_error(
-                        util::concat("reading piece file ", fileName, ": line ", lineNum, ": ", e.what()));
-                }
-
-                // append to list
-                validMoves.insert(sdl::primitives::Point{{x, y}});
-            }
-            break;
-        }
-        case PieceFileState::WhiteFileName: {
-            whiteFile = line;
-            state = PieceFileState::BlackFileName;
-            break;
-        }
-        case PieceFileState::BlackFileName: {
-            blackFile = line;
-            state = PieceFileState::Done;
-            break;
-        }
-        case PieceFileState::Done: {
-            throw std::runtime_error(util::concat("reading piece file ", fileName, ": line ", lineNum,
-                                                  ": Unexpected line '", line, "', expected EOF\n"));
-        }
-        }
-        lineNum += 1;
+        throw std::runtime_error(util::concat("reading packed piece ", key, ": pack has no such piece"));
     }
-    // load images
-    auto whiteSurface = imgContext.load(whiteFile);
-    auto blackSurface = imgContext.load(blackFile);
-    return chess::PieceFactory(validMoves, std::move(whiteSurface), std::move(blackSurface));
+    return chess::PieceFactory(pack.getMoves(*index), viewImage(pack.getImage(*index, rules::Color::White)),
+                               viewImage(pack.getImage(*index, rules::Color::Black)));
 }
-} // namespace io
\ No newline at end of file
+} // namespace io
@@ -8,9 +8,8 @@
 #ifndef IO_PIECE_HH
 #define IO_PIECE_HH
 
-#include <chess/piece.hh>
 #include <chess/piece_factory.hh>
-#include <chess/piece_images.hh>
+#include <io/piece_pack.hh>
 #include <sdl_wrapper/image/context.hh>
 #include <sdl_wrapper/render/renderer.hh>
 #include <string_view>
@@ -23,13 +22,24 @@
 namespace io
 {
 /**
- * @brief Read a piece file and create a PieceFactory representing that kind of piece.
+ * @brief Read a piece file and create a PieceFactory representing that kind of piece. The images are found relative
+ * to the piece file. Loading keeps no state outside the factory, so files may be read on several threads at once.
  *
  * @param imgContext used to load images from file
  * @param fileName the piece file name
  * @return chess::PieceFactory
  */
 chess::PieceFactory readPieceFile(sdl::image::Context &imgContext, std::string_view fileName);
+/**
+ * @brief Create a PieceFactory for a piece type in a piece pack. Its images are not copied: they are surfaces over the
+ * pack's mapped pixels, so the pack must outlive the factory.
+ *
+ * @param pack the pack
+ * @param key the name of the piece's file without the extension
+ * @return chess::PieceFactory
+ * @throw std::runtime_error if the pack does not have the piece
+ */
+chess::PieceFactory readPackedPiece(const PiecePack &pack, std::string_view key);
 } // namespace io
 
 #endif // IO_PIECE_HH
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "piece_loader.hh"
+#include <algorithm>
+#include <io/piece_file.hh>
+
+namespace io
+{
+PieceLoader::PieceLoader(sdl::image::Context &imgContext, std::vector<std::string> fileNames, int threads)
+    : imgContext(imgContext), fileNames(std::move(fileNames)), factories(this->fileNames.size()), nextFile(0),
+      loaded(0), stopped(false), error(nullptr)
+{
+    if (threads <= 0)
+    {
+        threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    threads = std::min(threads, static_cast<int>(this->fileNames.size()));
+    for (int i = 0; i < threads; i++)
+    {
+        workers.emplace_back([this] { work(); });
+    }
+}
+
+PieceLoader::~PieceLoader()
+{
+    stopped = true;
+    join();
+}
+
+int PieceLoader::getLoadedCount() const noexcept
+{
+    return loaded.load(std::memory_order_acquire);
+}
+
+int PieceLoader::size() const noexcept
+{
+    return static_cast<int>(fileNames.size());
+}
+
+bool PieceLoader::isDone() const noexcept
+{
+    return getLoadedCount() == size() || stopped.load(std::memory_order_acquire);
+}
+
+chess::PieceRegistry PieceLoader::finish()
+{
+    join();
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+    chess::PieceRegistry registry;
+    for (std::optional<chess::PieceFactory> &factory : factories)
+    {
+        registry.add(std::move(*factory));
+    }
+    factories.clear();
+    return registry;
+}
+
+void PieceLoader::work()
+{
+    while (!stopped.load(std::memory_order_acquire))
+    {
+        std::size_t file = nextFile.fetch_add(1);
+        if (file >= fileNames.size())
+        {
+            return;
+        }
+        try
+        {
+            factories[file].emplace(readPieceFile(imgContext, fileNames[file]));
+            loaded.fetch_add(1, std::memory_order_release);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+            stopped = true;
+        }
+    }
+}
+
+void PieceLoader::join()
+{
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+    workers.clear();
+}
+} // namespace io
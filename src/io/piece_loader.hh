@@ -0,0 +1,142 @@
+/**
+ * @file piece_loader.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains the PieceLoader class
+ * @date 2026-10-17
+ */
+
+#ifndef IO_PIECE_LOADER_HH
+#define IO_PIECE_LOADER_HH
+
+#include <atomic>
+#include <chess/piece_factory.hh>
+#include <chess/piece_registry.hh>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <sdl_wrapper/image/context.hh>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace io
+{
+/**
+ * @brief Loads piece files on a pool of worker threads: each worker parses piece files and decodes their images
+ * until none are left, so that startup is not bound by decoding one image at a time.
+ *
+ * The workers only create surfaces. Textures must be created on the render thread, so once every piece is loaded,
+ * finish() hands the pieces over as a PieceRegistry, whose images a chess::PieceAtlas renders into one texture when
+ * the game is drawn. Until then, the render thread is free to show the progress of the load.
+ *
+ */
+class PieceLoader
+{
+  public:
+    /**
+     * @brief Start loading piece files.
+     *
+     * @param imgContext used to load images from file; it must outlive the loader
+     * @param fileNames the piece file names, in the order of the types in the registry
+     * @param threads the number of worker threads, or 0 for one per core
+     */
+    PieceLoader(sdl::image::Context &imgContext, std::vector<std::string> fileNames, int threads = 0);
+    /**
+     * @brief Stop loading, once the files being loaded are done, and wait for the workers.
+     *
+     */
+    ~PieceLoader();
+    PieceLoader(const PieceLoader &) = delete;
+    PieceLoader &operator=(const PieceLoader &) = delete;
+
+    /**
+     * @brief Get the number of piece files loaded so far.
+     *
+     * @return int the number of files
+     */
+    int getLoadedCount() const noexcept;
+    /**
+     * @brief Get the number of piece files to load.
+     *
+     * @return int the number of files
+     */
+    int size() const noexcept;
+    /**
+     * @brief Check whether the load is over, because every file is loaded or one of them failed.
+     *
+     * @return true the load is over; finish() will not block
+     * @return false files are still being loaded
+     */
+    bool isDone() const noexcept;
+
+    /**
+     * @brief Wait for the load to finish and take the pieces.
+     *
+     * @return chess::PieceRegistry the pieces, in the order of their files, with their images not yet rendered
+     * @throw std::runtime_error if a piece file or image could not be loaded; the first error is rethrown
+     * @throw std::length_error if there are more files than piece types a registry can hold
+     */
+    chess::PieceRegistry finish();
+
+  private:
+    /**
+     * @brief Load files until none are left or one fails. Run by each worker thread.
+     *
+     */
+    void work();
+    /**
+     * @brief Stop the workers and wait for them.
+     *
+     */
+    void join();
+
+    /**
+     * @brief Used to load images.
+     *
+     */
+    sdl::image::Context &imgContext;
+    /**
+     * @brief The piece file names.
+     *
+     */
+    std::vector<std::string> fileNames;
+    /**
+     * @brief The loaded pieces, indexed like the file names. Each is written by one worker before `loaded` counts it.
+     *
+     */
+    std::vector<std::optional<chess::PieceFactory>> factories;
+    /**
+     * @brief The index of the next file for a worker to take.
+     *
+     */
+    std::atomic<std::size_t> nextFile;
+    /**
+     * @brief The number of files loaded.
+     *
+     */
+    std::atomic<int> loaded;
+    /**
+     * @brief Whether the workers should stop taking files, because one failed or the loader is being destroyed.
+     *
+     */
+    std::atomic<bool> stopped;
+    /**
+     * @brief The first error, if a file could not be loaded.
+     *
+     */
+    std::exception_ptr error;
+    /**
+     * @brief Guards `error`.
+     *
+     */
+    std::mutex errorMutex;
+    /**
+     * @brief The worker threads.
+     *
+     */
+    std::vector<std::thread> workers;
+};
+} // namespace io
+
+#endif // IO_PIECE_LOADER_HH
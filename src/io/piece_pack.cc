@@ -0,0 +1,459 @@
+#include "piece_pack.hh"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <io/piece_definition.hh>
+#include <limits>
+#include <stdexcept>
+#include <util/util.hh>
+
+namespace io
+{
+/**
+ * @brief The bytes a piece pack starts with.
+ *
+ */
+static constexpr char PACK_MAGIC[8] = {'C', 'V', 'P', 'I', 'E', 'C', 'E', 'S'};
+/**
+ * @brief A number written in the machine's byte order, so that a pack from a machine of another byte order is
+ * recognized.
+ *
+ */
+static constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+/**
+ * @brief The alignment of each section of moves and pixels within a pack, so that they can be used in place.
+ *
+ */
+static constexpr std::uint64_t PACK_ALIGNMENT = 16;
+
+/**
+ * @brief The start of a piece pack.
+ *
+ */
+struct PackHeader
+{
+    /**
+     * @brief PACK_MAGIC.
+     *
+     */
+    char magic[sizeof(PACK_MAGIC)];
+    /**
+     * @brief The version of the format, PIECE_PACK_VERSION.
+     *
+     */
+    std::uint32_t version;
+    /**
+     * @brief BYTE_ORDER_MARK, in the byte order of the machine that wrote the pack.
+     *
+     */
+    std::uint32_t byteOrder;
+    /**
+     * @brief The number of piece records following the header.
+     *
+     */
+    std::uint32_t pieceCount;
+    /**
+     * @brief Zero.
+     *
+     */
+    std::uint32_t reserved;
+    /**
+     * @brief The size of the whole pack in bytes.
+     *
+     */
+    std::uint64_t size;
+};
+
+/**
+ * @brief Where to find one of a piece's images in a pack.
+ *
+ */
+struct PackImage
+{
+    /**
+     * @brief The width in pixels.
+     *
+     */
+    std::uint32_t width;
+    /**
+     * @brief The height in pixels.
+     *
+     */
+    std::uint32_t height;
+    /**
+     * @brief The offset of the pixels from the start of the pack.
+     *
+     */
+    std::uint32_t pixels;
+    /**
+     * @brief Zero.
+     *
+     */
+    std::uint32_t reserved;
+};
+
+/**
+ * @brief Where to find a piece's key, name, moves and images in a pack.
+ *
+ */
+struct PackRecord
+{
+    /**
+     * @brief The offset of the key from the start of the pack.
+     *
+     */
+    std::uint32_t key;
+    /**
+     * @brief The length of the key.
+     *
+     */
+    std::uint32_t keyLength;
+    /**
+     * @brief The offset of the name from the start of the pack.
+     *
+     */
+    std::uint32_t name;
+    /**
+     * @brief The length of the name.
+     *
+     */
+    std::uint32_t nameLength;
+    /**
+     * @brief The offset of the moves from the start of the pack.
+     *
+     */
+    std::uint32_t moves;
+    /**
+     * @brief The number of moves.
+     *
+     */
+    std::uint32_t moveCount;
+    /**
+     * @brief The images, indexed by color.
+     *
+     */
+    PackImage images[rules::COLOR_COUNT];
+};
+
+/**
+ * @brief A move in a pack.
+ *
+ */
+struct PackMove
+{
+    /**
+     * @brief rules::Offset::dx.
+     *
+     */
+    std::int32_t dx;
+    /**
+     * @brief rules::Offset::dy.
+     *
+     */
+    std::int32_t dy;
+    /**
+     * @brief rules::Offset::range.
+     *
+     */
+    std::int32_t range;
+    /**
+     * @brief The move's MoveFlags.
+     *
+     */
+    std::uint32_t flags;
+};
+
+static_assert(sizeof(PackHeader) == 32 && sizeof(PackRecord) == 56 && sizeof(PackMove) == 16,
+              "piece pack structures must not be padded");
+
+/**
+ * @brief The flags of a move in a pack.
+ *
+ */
+enum MoveFlags : std::uint32_t
+{
+    Hop = 1,
+    Lame = 2,
+    Quiet = 4,
+    Capture = 8,
+    AllFlags = Hop | Lame | Quiet | Capture
+};
+
+/**
+ * @brief Read a structure from a pack. The pack's contents need not be aligned.
+ *
+ * @tparam T the structure's type
+ * @param bytes the structure's first byte
+ * @return T the structure
+ */
+template <typename T> static T readStruct(const unsigned char *bytes)
+{
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+/**
+ * @brief Convert a move from how it is stored in a pack.
+ *
+ * @param packed the stored move
+ * @return rules::Offset the move
+ */
+static rules::Offset unpackMove(const PackMove &packed)
+{
+    rules::Offset move{packed.dx, packed.dy};
+    move.range = packed.range;
+    move.hop = (packed.flags & Hop) != 0;
+    move.lame = (packed.flags & Lame) != 0;
+    move.quiet = (packed.flags & Quiet) != 0;
+    move.capture = (packed.flags & Capture) != 0;
+    return move;
+}
+
+/**
+ * @brief Round an offset up to PACK_ALIGNMENT.
+ *
+ * @param offset the offset
+ * @return std::uint64_t the aligned offset
+ */
+static std::uint64_t align(std::uint64_t offset)
+{
+    return (offset + PACK_ALIGNMENT - 1) / PACK_ALIGNMENT * PACK_ALIGNMENT;
+}
+
+/**
+ * @brief Get the number of bytes of an image's pixels.
+ *
+ * @param width the width in pixels
+ * @param height the height in pixels
+ * @return std::uint64_t the number of bytes
+ */
+static std::uint64_t pixelBytes(std::uint64_t width, std::uint64_t height)
+{
+    return width * height * PACKED_PIXEL_SIZE;
+}
+
+PiecePack::PiecePack(std::string_view fileName) : file(fileName), pieceCount(0)
+{
+    auto fail = [&](std::string_view problem) {
+        return std::runtime_error(util::concat("reading piece pack ", fileName, ": ", problem));
+    };
+    std::uint64_t size = file.size();
+    if (size < sizeof(PackHeader))
+    {
+        throw fail("file is too short to be a piece pack");
+    }
+    PackHeader header = readStruct<PackHeader>(file.data());
+    if (std::memcmp(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0)
+    {
+        throw fail("not a piece pack");
+    }
+    if (header.version != PIECE_PACK_VERSION)
+    {
+        throw fail(util::concat("pack is version ", header.version, ", expected version ", PIECE_PACK_VERSION,
+                                "; compile it again with piecepack"));
+    }
+    if (header.byteOrder != BYTE_ORDER_MARK)
+    {
+        throw fail("pack was compiled on a machine of another byte order; compile it again with piecepack");
+    }
+    if (header.size != size || header.pieceCount > (size - sizeof(PackHeader)) / sizeof(PackRecord))
+    {
+        throw fail("pack is truncated");
+    }
+    pieceCount = static_cast<int>(header.pieceCount);
+
+    // check every record once, so that the accessors need not
+    auto inBounds = [&](std::uint64_t offset, std::uint64_t length) {
+        return offset <= size && length <= size - offset;
+    };
+    for (int i = 0; i < pieceCount; i++)
+    {
+        PackRecord record = readStruct<PackRecord>(recordOf(i));
+        if (!inBounds(record.key, record.keyLength) || !inBounds(record.name, record.nameLength) ||
+            !inBounds(record.moves, std::uint64_t(record.moveCount) * sizeof(PackMove)))
+        {
+            throw fail(util::concat("piece ", i, " is out of bounds"));
+        }
+        for (const PackImage &image : record.images)
+        {
+            if (image.width == 0 || image.height == 0 || image.width > std::numeric_limits<int>::max() ||
+                image.height > std::numeric_limits<int>::max() ||
+                !inBounds(image.pixels, pixelBytes(image.width, image.height)))
+            {
+                throw fail(util::concat("image of piece '", getKey(i), "' is out of bounds"));
+            }
+        }
+        for (std::uint32_t m = 0; m < record.moveCount; m++)
+        {
+            // a pack is as trusted as the piece files it was compiled from, so its moves obey the same rules
+            PackMove move = readStruct<PackMove>(file.data() + record.moves + m * sizeof(PackMove));
+            const char *error = (move.flags & ~AllFlags) != 0 ? "unknown flags" : checkMove(unpackMove(move));
+            if (error)
+            {
+                throw fail(util::concat("move ", m, " of piece '", getKey(i), "' is malformed: ", error));
+            }
+        }
+        if (i > 0 && !(getKey(i - 1) < getKey(i)))
+        {
+            throw fail("pieces are not sorted by key");
+        }
+    }
+}
+
+int PiecePack::size() const noexcept
+{
+    return pieceCount;
+}
+
+std::optional<int> PiecePack::find(std::string_view key) const
+{
+    int low = 0;
+    int high = pieceCount;
+    while (low < high)
+    {
+        int middle = low + (high - low) / 2;
+        std::string_view middleKey = getKey(middle);
+        if (middleKey == key)
+        {
+            return middle;
+        }
+        if (middleKey < key)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return std::nullopt;
+}
+
+std::string_view PiecePack::getKey(int index) const
+{
+    PackRecord record = readStruct<PackRecord>(recordOf(index));
+    return std::string_view(reinterpret_cast<const char *>(file.data() + record.key), record.keyLength);
+}
+
+std::string_view PiecePack::getName(int index) const
+{
+    PackRecord record = readStruct<PackRecord>(recordOf(index));
+    return std::string_view(reinterpret_cast<const char *>(file.data() + record.name), record.nameLength);
+}
+
+std::vector<rules::Offset> PiecePack::getMoves(int index) const
+{
+    PackRecord record = readStruct<PackRecord>(recordOf(index));
+    std::vector<rules::Offset> moves;
+    moves.reserve(record.moveCount);
+    for (std::uint32_t m = 0; m < record.moveCount; m++)
+    {
+        moves.push_back(unpackMove(readStruct<PackMove>(file.data() + record.moves + m * sizeof(PackMove))));
+    }
+    return moves;
+}
+
+PieceImageView PiecePack::getImage(int index, rules::Color color) const
+{
+    PackImage image = readStruct<PackRecord>(recordOf(index)).images[rules::indexOf(color)];
+    return PieceImageView{static_cast<int>(image.width), static_cast<int>(image.height), file.data() + image.pixels};
+}
+
+const unsigned char *PiecePack::recordOf(int index) const
+{
+    return file.data() + sizeof(PackHeader) + static_cast<std::size_t>(index) * sizeof(PackRecord);
+}
+
+void writePiecePack(std::string_view fileName, std::vector<PackedPiece> pieces)
+{
+    auto fail = [&](std::string_view problem) {
+        return std::runtime_error(util::concat("writing piece pack ", fileName, ": ", problem));
+    };
+    std::sort(pieces.begin(), pieces.end(),
+              [](const PackedPiece &a, const PackedPiece &b) { return a.key < b.key; });
+    auto sameKey = std::adjacent_find(pieces.begin(), pieces.end(),
+                                      [](const PackedPiece &a, const PackedPiece &b) { return a.key == b.key; });
+    if (sameKey != pieces.end())
+    {
+        throw fail(util::concat("more than one piece has the key '", sameKey->key, "'"));
+    }
+
+    // lay the pack out: the header and records, then the strings, then the moves and pixels, each aligned
+    std::vector<PackRecord> records(pieces.size());
+    std::uint64_t size = sizeof(PackHeader) + pieces.size() * sizeof(PackRecord);
+    auto place = [&](std::uint64_t length) {
+        std::uint64_t offset = size;
+        size += length;
+        if (size > std::numeric_limits<std::uint32_t>::max())
+        {
+            throw fail("pack would be larger than 4 GiB");
+        }
+        return static_cast<std::uint32_t>(offset);
+    };
+    for (std::size_t i = 0; i < pieces.size(); i++)
+    {
+        records[i].key = place(pieces[i].key.size());
+        records[i].keyLength = static_cast<std::uint32_t>(pieces[i].key.size());
+        records[i].name = place(pieces[i].name.size());
+        records[i].nameLength = static_cast<std::uint32_t>(pieces[i].name.size());
+    }
+    for (std::size_t i = 0; i < pieces.size(); i++)
+    {
+        size = align(size);
+        records[i].moves = place(pieces[i].moves.size() * sizeof(PackMove));
+        records[i].moveCount = static_cast<std::uint32_t>(pieces[i].moves.size());
+        for (rules::Color color : {rules::Color::White, rules::Color::Black})
+        {
+            const PieceImage &image = color == rules::Color::White ? pieces[i].whiteImage : pieces[i].blackImage;
+            if (image.width <= 0 || image.height <= 0 ||
+                image.pixels.size() != pixelBytes(std::uint64_t(image.width), std::uint64_t(image.height)))
+            {
+                throw fail(util::concat("image of piece '", pieces[i].key, "' does not match its size"));
+            }
+            size = align(size);
+            PackImage &packed = records[i].images[rules::indexOf(color)];
+            packed.width = static_cast<std::uint32_t>(image.width);
+            packed.height = static_cast<std::uint32_t>(image.height);
+            packed.pixels = place(image.pixels.size());
+            packed.reserved = 0;
+        }
+    }
+
+    std::vector<unsigned char> bytes(size, 0);
+    PackHeader header;
+    std::memcpy(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC));
+    header.version = PIECE_PACK_VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.pieceCount = static_cast<std::uint32_t>(pieces.size());
+    header.reserved = 0;
+    header.size = size;
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    for (std::size_t i = 0; i < pieces.size(); i++)
+    {
+        const PackRecord &record = records[i];
+        std::memcpy(bytes.data() + sizeof(PackHeader) + i * sizeof(PackRecord), &record, sizeof(record));
+        std::copy(pieces[i].key.begin(), pieces[i].key.end(), bytes.begin() + record.key);
+        std::copy(pieces[i].name.begin(), pieces[i].name.end(), bytes.begin() + record.name);
+        for (std::size_t m = 0; m < pieces[i].moves.size(); m++)
+        {
+            const rules::Offset &move = pieces[i].moves[m];
+            PackMove packed{move.dx, move.dy, move.range,
+                            (move.hop ? Hop : 0u) | (move.lame ? Lame : 0u) | (move.quiet ? Quiet : 0u) |
+                                (move.capture ? Capture : 0u)};
+            std::memcpy(bytes.data() + record.moves + m * sizeof(PackMove), &packed, sizeof(packed));
+        }
+        std::copy(pieces[i].whiteImage.pixels.begin(), pieces[i].whiteImage.pixels.end(),
+                  bytes.begin() + record.images[rules::indexOf(rules::Color::White)].pixels);
+        std::copy(pieces[i].blackImage.pixels.begin(), pieces[i].blackImage.pixels.end(),
+                  bytes.begin() + record.images[rules::indexOf(rules::Color::Black)].pixels);
+    }
+
+    std::ofstream file(std::string(fileName), std::ios::binary);
+    file.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!file)
+    {
+        throw fail("could not write file");
+    }
+}
+} // namespace io
@@ -0,0 +1,210 @@
+/**
+ * @file piece_pack.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains the PiecePack class and functions for writing piece packs
+ * @date 2026-10-17
+ */
+
+#ifndef IO_PIECE_PACK_HH
+#define IO_PIECE_PACK_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <rules/types.hh>
+#include <string>
+#include <string_view>
+#include <util/mapped_file.hh>
+#include <vector>
+
+namespace io
+{
+/**
+ * @brief The version of the piece pack format written by writePiecePack(). Packs of any other version are rejected,
+ * and must be compiled again.
+ *
+ */
+constexpr std::uint32_t PIECE_PACK_VERSION = 1;
+/**
+ * @brief The number of bytes per pixel of a packed image. Pixels are stored as 8-bit red, green, blue and alpha, in
+ * that order in memory, with the rows packed together.
+ *
+ */
+constexpr int PACKED_PIXEL_SIZE = 4;
+
+/**
+ * @brief A decoded image, as written to a piece pack.
+ *
+ */
+struct PieceImage
+{
+    /**
+     * @brief The width in pixels.
+     *
+     */
+    int width;
+    /**
+     * @brief The height in pixels.
+     *
+     */
+    int height;
+    /**
+     * @brief The pixels, PACKED_PIXEL_SIZE bytes each, top row first.
+     *
+     */
+    std::vector<unsigned char> pixels;
+};
+
+/**
+ * @brief A decoded image in a mapped piece pack.
+ *
+ */
+struct PieceImageView
+{
+    /**
+     * @brief The width in pixels.
+     *
+     */
+    int width;
+    /**
+     * @brief The height in pixels.
+     *
+     */
+    int height;
+    /**
+     * @brief The pixels, PACKED_PIXEL_SIZE bytes each, top row first. They are valid while the pack is mapped.
+     *
+     */
+    const unsigned char *pixels;
+};
+
+/**
+ * @brief A piece type as written to a piece pack: its piece file, parsed, and its images, decoded.
+ *
+ */
+struct PackedPiece
+{
+    /**
+     * @brief The name the piece is looked up by, the name of its piece file without the extension.
+     *
+     */
+    std::string key;
+    /**
+     * @brief The piece's name.
+     *
+     */
+    std::string name;
+    /**
+     * @brief The piece's moves, relative to its square.
+     *
+     */
+    std::vector<rules::Offset> moves;
+    /**
+     * @brief The white version's image.
+     *
+     */
+    PieceImage whiteImage;
+    /**
+     * @brief The black version's image.
+     *
+     */
+    PieceImage blackImage;
+};
+
+/**
+ * @brief A piece pack mapped into memory: a catalog of piece types compiled from their piece files and images by the
+ * piecepack tool, so that the game starts without parsing text or decoding images.
+ *
+ * A pack is a header, then a fixed-size record per piece sorted by key, then the pieces' names, moves and pixels,
+ * which are used in place. The whole pack is checked when it is opened, so a truncated or corrupt pack is rejected
+ * there rather than read out of bounds later. Packs are written in the byte order of the machine that compiled them.
+ *
+ */
+class PiecePack
+{
+  public:
+    /**
+     * @brief Map a piece pack and check its contents.
+     *
+     * @param fileName the pack's file name
+     * @throw std::runtime_error if the pack cannot be mapped, is of another version or byte order, or is malformed
+     */
+    explicit PiecePack(std::string_view fileName);
+
+    /**
+     * @brief Get the number of piece types in the pack.
+     *
+     * @return int the number of types
+     */
+    int size() const noexcept;
+    /**
+     * @brief Find a piece type by its key.
+     *
+     * @param key the name of the piece's file without the extension
+     * @return std::optional<int> the piece's index, or std::nullopt if the pack does not have it
+     */
+    std::optional<int> find(std::string_view key) const;
+
+    /**
+     * @brief Get a piece's key.
+     *
+     * @param index the piece's index, less than size()
+     * @return std::string_view the key, valid while the pack is mapped
+     */
+    std::string_view getKey(int index) const;
+    /**
+     * @brief Get a piece's name.
+     *
+     * @param index the piece's index, less than size()
+     * @return std::string_view the name, valid while the pack is mapped
+     */
+    std::string_view getName(int index) const;
+    /**
+     * @brief Get a piece's moves.
+     *
+     * @param index the piece's index, less than size()
+     * @return std::vector<rules::Offset> the moves, relative to the piece's square
+     */
+    std::vector<rules::Offset> getMoves(int index) const;
+    /**
+     * @brief Get one of a piece's images.
+     *
+     * @param index the piece's index, less than size()
+     * @param color the color of the version of the piece
+     * @return PieceImageView the image, valid while the pack is mapped
+     */
+    PieceImageView getImage(int index, rules::Color color) const;
+
+  private:
+    /**
+     * @brief Get the start of a piece's record.
+     *
+     * @param index the piece's index
+     * @return const unsigned char* the record
+     */
+    const unsigned char *recordOf(int index) const;
+
+    /**
+     * @brief The mapped pack.
+     *
+     */
+    util::MappedFile file;
+    /**
+     * @brief The number of piece types in the pack.
+     *
+     */
+    int pieceCount;
+};
+
+/**
+ * @brief Write a piece pack that PiecePack can map.
+ *
+ * @param fileName the pack's file name
+ * @param pieces the piece types, in any order
+ * @throw std::runtime_error if two pieces share a key, an image's pixels do not match its size, the pack would be
+ * too large, or the file cannot be written
+ */
+void writePiecePack(std::string_view fileName, std::vector<PackedPiece> pieces);
+} // namespace io
+
+#endif // IO_PIECE_PACK_HH
@@ -0,0 +1,117 @@
+#include "tokenizer.hh"
+#include <util/util.hh>
+
+namespace io
+{
+/**
+ * @brief Check whether a character is whitespace, without depending on the locale.
+ *
+ * @param c the character
+ * @return true the character is whitespace
+ * @return false the character is not whitespace
+ */
+static bool isBlank(char c) noexcept
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+}
+
+Tokenizer::Tokenizer(std::string_view text, std::string source)
+    : text(text), source(std::move(source)), next(0), lineStart(text.data()), line(), lineNumber(0)
+{
+}
+
+bool Tokenizer::nextLine()
+{
+    while (next < text.size())
+    {
+        std::size_t end = text.find('\n', next);
+        if (end == std::string_view::npos)
+        {
+            end = text.size();
+        }
+        std::string_view raw = text.substr(next, end - next);
+        lineStart = raw.data();
+        lineNumber++;
+        next = end + 1;
+        line = trimView(raw);
+        if (!line.empty() && raw[0] != '#')
+        {
+            return true;
+        }
+    }
+    line = std::string_view();
+    return false;
+}
+
+std::string_view Tokenizer::getLine() const noexcept
+{
+    return line;
+}
+
+int Tokenizer::parseInt(std::string_view token) const
+{
+    int value = 0;
+    std::errc status = util::parseInt(token, value);
+    if (status == std::errc::result_out_of_range)
+    {
+        throw error(token, util::concat("'", token, "' is out of range"));
+    }
+    if (status != std::errc())
+    {
+        throw error(token, util::concat("'", token, "' is not an integer"));
+    }
+    return value;
+}
+
+std::runtime_error Tokenizer::error(std::string_view token, std::string_view message) const
+{
+    // tokens are views of the current line, so their column is their distance from its start
+    std::ptrdiff_t column = token.data() - lineStart;
+    if (token.data() == nullptr || column < 0 || column > line.data() + line.size() - lineStart)
+    {
+        column = line.data() - lineStart;
+    }
+    return std::runtime_error(
+        util::concat("reading ", source, ": line ", lineNumber, ", column ", column + 1, ": ", message));
+}
+
+std::string_view trimView(std::string_view s) noexcept
+{
+    std::size_t first = 0;
+    while (first < s.size() && isBlank(s[first]))
+    {
+        first++;
+    }
+    std::size_t last = s.size();
+    while (last > first && isBlank(s[last - 1]))
+    {
+        last--;
+    }
+    return s.substr(first, last - first);
+}
+
+std::string_view nextToken(std::string_view &rest, char separator) noexcept
+{
+    std::size_t end = rest.find(separator);
+    std::string_view token = trimView(rest.substr(0, end));
+    rest = end == std::string_view::npos ? rest.substr(rest.size()) : rest.substr(end + 1);
+    return token;
+}
+
+std::string_view nextWord(std::string_view &rest) noexcept
+{
+    std::size_t first = 0;
+    while (first < rest.size() && isBlank(rest[first]))
+    {
+        first++;
+    }
+    std::size_t last = first;
+    while (last < rest.size() && !isBlank(rest[last]))
+    {
+        last++;
+    }
+    std::string_view word = rest.substr(first, last - first);
+    rest = rest.substr(last);
+    return word;
+}
+} // namespace io
@@ -0,0 +1,125 @@
+/**
+ * @file tokenizer.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains the Tokenizer class and functions for splitting lines of text into tokens
+ * @date 2026-10-17
+ */
+
+#ifndef IO_TOKENIZER_HH
+#define IO_TOKENIZER_HH
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace io
+{
+/**
+ * @brief Reads the lines of a text file in memory, such as a mapped file, one at a time. Lines and tokens are views
+ * of the text rather than copies, so nothing is allocated per line, and errors are reported at the line and column
+ * of the token they are about.
+ *
+ * Blank lines, and comment lines starting with '#', are skipped.
+ *
+ */
+class Tokenizer
+{
+  public:
+    /**
+     * @brief Start reading a text.
+     *
+     * @param text the text, which must outlive the tokenizer and the tokens it returns
+     * @param source what the text is, for error messages, such as `piece file knight.piece`
+     */
+    Tokenizer(std::string_view text, std::string source);
+
+    /**
+     * @brief Move to the next line that is neither blank nor a comment.
+     *
+     * @return true there is a line
+     * @return false the end of the text was reached
+     */
+    bool nextLine();
+    /**
+     * @brief Get the current line, without whitespace at either end.
+     *
+     * @return std::string_view the line
+     */
+    std::string_view getLine() const noexcept;
+
+    /**
+     * @brief Parse an integer token of the current line, in decimal with an optional sign.
+     *
+     * @param token the token, a view of the current line
+     * @return int the integer
+     * @throw std::runtime_error if the token is not an integer or does not fit in an int
+     */
+    int parseInt(std::string_view token) const;
+    /**
+     * @brief Create an error about a token of the current line.
+     *
+     * @param token the token, a view of the current line; errors about the whole line should pass getLine()
+     * @param message what is wrong
+     * @return std::runtime_error the error, naming the source, line and column
+     */
+    std::runtime_error error(std::string_view token, std::string_view message) const;
+
+  private:
+    /**
+     * @brief The text.
+     *
+     */
+    std::string_view text;
+    /**
+     * @brief What the text is, for error messages.
+     *
+     */
+    std::string source;
+    /**
+     * @brief The offset in the text of the line after the current one.
+     *
+     */
+    std::size_t next;
+    /**
+     * @brief The start of the current line, before any whitespace is trimmed.
+     *
+     */
+    const char *lineStart;
+    /**
+     * @brief The current line, trimmed.
+     *
+     */
+    std::string_view line;
+    /**
+     * @brief The number of the current line, counting from 1, or 0 before the first line.
+     *
+     */
+    int lineNumber;
+};
+
+/**
+ * @brief Remove whitespace from either end of a view, without copying it.
+ *
+ * @param s the view
+ * @return std::string_view the trimmed view
+ */
+std::string_view trimView(std::string_view s) noexcept;
+/**
+ * @brief Split off the text before the first separator, trimmed. The rest of the text is left after the separator.
+ *
+ * @param rest the text to split; on return, the text after the separator, or empty if there is none
+ * @param separator the separator
+ * @return std::string_view the text before the separator, or all the text if there is none
+ */
+std::string_view nextToken(std::string_view &rest, char separator) noexcept;
+/**
+ * @brief Split off the first word of a text separated by whitespace.
+ *
+ * @param rest the text to split; on return, the text after the word
+ * @return std::string_view the word, or empty if there are no more words
+ */
+std::string_view nextWord(std::string_view &rest) noexcept;
+} // namespace io
+
+#endif // IO_TOKENIZER_HH
@@ -7,14 +7,27 @@
 
 #include <SDL2/SDL_events.h>
 #include <SDL2/SDL_stdinc.h>
+#include <SDL2/SDL_timer.h>
 #include <sdl_wrapper/context.hh>
+#include <sdl_wrapper/image/context.hh>
 #include <sdl_wrapper/render/renderer.hh>
+#include <sdl_wrapper/render/renderer_builder.hh>
 #include <sdl_wrapper/render/texture.hh>
 #include <sdl_wrapper/video/window.hh>
 
+#include <algorithm>
 #include <chess/chessGame.hh>
+#include <chess/piece_registry.hh>
 #include <cmath>
+#include <filesystem>
+#include <io/layout_file.hh>
+#include <io/piece_file.hh>
+#include <io/piece_loader.hh>
+#include <io/piece_pack.hh>
 #include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <sdl_wrapper/sdl_exception.hh>
 #include <util/util.hh>
 #include <vector>
@@ -38,19 +51,150 @@ constexpr int INITIAL_WIDTH = 720;
  */
 constexpr int INITIAL_HEIGHT = 480;
 
+/**
+ * @brief The piece pack mapped at startup, compiled from resources/piecedata by the piecepack tool. Its keys are the
+ * names of the piece files, without their extension.
+ *
+ */
+constexpr const char *PIECE_PACK = "resources/pieces.pack";
+/**
+ * @brief The layout the game opens with, whose piece files are loaded at startup when there is no piece pack
+ *
+ */
+constexpr const char *LAYOUT_FILE = "resources/layouts/skirmish.layout";
+/**
+ * @brief How often the progress of loading the pieces is redrawn, in milliseconds
+ *
+ */
+constexpr int LOAD_PROGRESS_INTERVAL = 16;
+/**
+ * @brief The longest the game sleeps waiting for an event when nothing needs to be drawn, in milliseconds
+ *
+ */
+constexpr int IDLE_WAIT = 500;
+/**
+ * @brief How long the window size must stay the same before the board is drawn again at the new size, in milliseconds.
+ * Until then, the board drawn at the old size is stretched, so that a live resize does not redraw it every step.
+ *
+ */
+constexpr int RESIZE_SETTLE_TIME = 150;
+/**
+ * @brief The number of milliseconds in a second
+ *
+ */
+constexpr int MS_PER_SECOND = 1000;
+
+/**
+ * @brief Show a progress bar until the pieces are loaded, handling window events meanwhile.
+ *
+ * @param renderer the renderer to draw with
+ * @param loader the load in progress
+ * @param width the window width, updated if the window is resized
+ * @param height the window height, updated if the window is resized
+ * @return true the load is done
+ * @return false the window was closed first
+ */
+static bool showLoadProgress(sdl::render::Renderer &renderer, const io::PieceLoader &loader, int &width, int &height)
+{
+    constexpr SDL_Color BAR_COLOR = {0xaa, 0xaa, 0xaa, 0xff};
+    while (!loader.isDone())
+    {
+        SDL_Event e;
+        if (SDL_WaitEventTimeout(&e, LOAD_PROGRESS_INTERVAL) != 0)
+        {
+            if (e.type == SDL_QUIT)
+            {
+                return false;
+            }
+            if (e.type == SDL_WINDOWEVENT && e.window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
+            {
+                width = e.window.data1;
+                height = e.window.data2;
+            }
+        }
+
+        // an outlined bar across the middle half of the window, filled in as pieces load
+        SDL_Rect bar = {width / 4, height / 2 - height / 40, width / 2, std::max(height / 20, 2)};
+        SDL_Rect filled = bar;
+        filled.w = bar.w * loader.getLoadedCount() / std::max(loader.size(), 1);
+        renderer.setDrawColor(BG_COLOR);
+        renderer.clear();
+        renderer.setDrawColor(BAR_COLOR);
+        renderer.drawRect(bar);
+        renderer.fillRect(filled);
+        renderer.present();
+    }
+    return true;
+}
+
 /**
  * @brief The main function.
  *
+ * The window is only drawn again when something changes: the loop sleeps until an event arrives, and an event that
+ * changes the window or the game marks the frame as out of date. With a frame cap, frames are drawn no more often
+ * than the cap allows, however quickly they go out of date, such as during a resize.
+ *
+ * With `software`, the window is drawn by the software renderer, and only the squares that changed are drawn again
+ * and pushed to the screen, so that a frame costs in proportion to how much changed rather than to the window's size.
+ *
+ * @param argc the number of arguments
+ * @param argv the arguments: optionally the most frames to draw per second, 0 for no cap, and then optionally `vsync`
+ * to wait for the display's vertical sync when presenting and `software` to draw without the GPU
  * @return int The exit status code.
  * 0 for success, non-zero for failure.
  */
-int main()
+int main(int argc, char **argv)
 {
+    bool vsync = false;
+    bool software = false;
+    for (int i = 2; i < argc; i++)
+    {
+        std::string_view option = argv[i];
+        if (option == "vsync")
+        {
+            vsync = true;
+        }
+        else if (option == "software")
+        {
+            software = true;
+        }
+        else
+        {
+            cerr << "usage: " << argv[0] << " [max frames per second] [vsync] [software]\n";
+            return 2;
+        }
+    }
+    int frameInterval = 0;
+    if (argc >= 2)
+    {
+        try
+        {
+            long maxFps = util::parseInt(argv[1]);
+            frameInterval = maxFps > 0 ? static_cast<int>(MS_PER_SECOND / std::min<long>(maxFps, MS_PER_SECOND)) : 0;
+        }
+        catch (std::exception &e)
+        {
+            cerr << argv[0] << ": " << e.what() << '\n';
+            return 2;
+        }
+    }
+
     int width = INITIAL_WIDTH;
     int height = INITIAL_HEIGHT;
     constexpr int MARGIN = 8; // percent out of 100
-    constexpr int GRID_NCOLS = 5;
-    constexpr int GRID_NROWS = 10;
+
+    io::Layout layout;
+    try
+    {
+        layout = io::readLayoutFile(LAYOUT_FILE);
+    }
+    catch (std::exception &e)
+    {
+        cerr << argv[0] << ": " << e.what() << '\n';
+        return 1;
+    }
+    const int nCols = layout.width;
+    const int nRows = layout.height;
 
     sdl::Context sdlContext;
     sdl::video::Context videoContext = sdlContext.initVideo();
@@ -58,17 +202,109 @@ int main()
     sdl::video::Window window =
         videoContext.createWindow("test window", 0, 0, width, height).positionCentered().resizable().build();
 
-    sdl::render::Renderer renderer = window.createRenderer().accelerated().build();
+    sdl::render::RendererBuilder rendererBuilder = window.createRenderer();
+    if (software)
+    {
+        rendererBuilder.software();
+    }
+    else
+    {
+        rendererBuilder.accelerated();
+    }
+    if (vsync)
+    {
+        rendererBuilder.presentVsync();
+    }
+    sdl::render::Renderer renderer = rendererBuilder.build();
+    // every frame sets the same few colors and targets; skip telling SDL what it already has
+    renderer.setStateCaching(true);
+
+    // the pack stays mapped for as long as the pieces' images are surfaces over its pixels
+    std::optional<io::PiecePack> piecePack;
+    chess::PieceRegistry pieces;
+    try
+    {
+        if (std::filesystem::exists(PIECE_PACK))
+        {
+            piecePack.emplace(PIECE_PACK);
+            for (const io::LayoutPiece &piece : layout.pieces)
+            {
+                pieces.add(io::readPackedPiece(*piecePack, std::filesystem::path(piece.fileName).stem().string()));
+            }
+        }
+        else
+        {
+            // decode the images on every core; their textures are created when the game is first drawn
+            sdl::image::Context imageContext(sdl::image::InitFlags::Png);
+            std::vector<std::string> fileNames;
+            for (const io::LayoutPiece &piece : layout.pieces)
+            {
+                fileNames.push_back(piece.fileName);
+            }
+            io::PieceLoader loader(imageContext, std::move(fileNames));
+            if (!showLoadProgress(renderer, loader, width, height))
+            {
+                return 0;
+            }
+            pieces = loader.finish();
+        }
+    }
+    catch (std::exception &e)
+    {
+        // show the board without pieces rather than not at all
+        cerr << argv[0] << ": could not load the pieces, playing without them: " << e.what() << '\n';
+        pieces = chess::PieceRegistry();
+        piecePack.reset();
+    }
+
+    // the registry holds the layout's pieces in its order, so the layout's type IDs are also the registry's
+    std::optional<rules::Position> startPosition;
+    if (pieces.size() == static_cast<int>(layout.pieces.size()))
+    {
+        try
+        {
+            rules::Variant variant = pieces.createVariant(io::createGeometry<rules::Bitboard>(layout));
+            startPosition = io::createPosition(layout, variant);
+        }
+        catch (std::exception &e)
+        {
+            cerr << argv[0] << ": could not set up " << LAYOUT_FILE << ", starting with an empty board: " << e.what()
+                 << '\n';
+        }
+    }
 
-    chess::ChessGame activeGame(GRID_NCOLS, GRID_NROWS);
+    chess::ChessGame activeGame(nCols, nRows, std::move(pieces));
+    if (startPosition)
+    {
+        activeGame.setPosition(*startPosition);
+    }
 
-    activeGame.redraw(renderer, width, height, MARGIN, GRID_NCOLS, GRID_NROWS);
+    activeGame.redraw(renderer, width, height, MARGIN, nCols, nRows);
 
     bool run = true;
+    // whether the frame on screen is out of date, and when the next one may be drawn
+    bool invalidated = true;
+    Uint32 nextFrame = SDL_GetTicks();
+    // whether the board is waiting to be drawn again at a new size, and when the size will have settled
+    bool resizing = false;
+    Uint32 resizeSettled = 0;
+    // the square an arrow being dragged with the right mouse button starts at
+    rules::Square arrowStart = rules::NO_SQUARE;
     while (run)
     {
+        // sleep until an event arrives, or until the next frame or the end of a resize is due
+        int timeout = IDLE_WAIT;
+        if (invalidated)
+        {
+            timeout = std::max(0, static_cast<int>(nextFrame - SDL_GetTicks()));
+        }
+        if (resizing)
+        {
+            timeout = std::min(timeout, std::max(0, static_cast<int>(resizeSettled - SDL_GetTicks())));
+        }
         SDL_Event e;
-        while (SDL_PollEvent(&e) != 0)
+        int pending = timeout > 0 ? SDL_WaitEventTimeout(&e, timeout) : SDL_PollEvent(&e);
+        for (; pending != 0 && run; pending = SDL_PollEvent(&e))
         {
             if (e.type == SDL_WINDOWEVENT)
             {
@@ -77,26 +313,113 @@ int main()
                 {
                     width = we.data1;
                     height = we.data2;
+                    // SDL resets the window's viewport to fit the new size
+                    renderer.invalidateStateCache();
+                    activeGame.resize(width, height, MARGIN, nCols, nRows);
+                    resizing = true;
+                    resizeSettled = SDL_GetTicks() + RESIZE_SETTLE_TIME;
+                }
+                else if (we.event == SDL_WINDOWEVENT_LEAVE)
+                {
+                    activeGame.setHover(rules::NO_SQUARE);
+                }
+                else if (we.event == SDL_WINDOWEVENT_EXPOSED || we.event == SDL_WINDOWEVENT_SHOWN ||
+                         we.event == SDL_WINDOWEVENT_RESTORED)
+                {
+                    activeGame.damageAll();
+                }
+                // any change to the window may have uncovered or resized what is drawn
+                invalidated = true;
+            }
+            else if (e.type == SDL_RENDER_TARGETS_RESET || e.type == SDL_RENDER_DEVICE_RESET)
+            {
+                // refresh all textures; after a device reset they are gone and must be created again
+                renderer.invalidateStateCache();
+                activeGame.redraw(renderer, width, height, MARGIN, nCols, nRows,
+                                  e.type == SDL_RENDER_DEVICE_RESET);
+                resizing = false;
+                invalidated = true;
+            }
+            else if (e.type == SDL_MOUSEMOTION)
+            {
+                // only the overlay changes, so the frame costs a few copies and rectangles
+                activeGame.setHover(activeGame.squareAt(e.motion.x, e.motion.y));
+            }
+            else if (e.type == SDL_MOUSEBUTTONDOWN)
+            {
+                rules::Square sq = activeGame.squareAt(e.button.x, e.button.y);
+                if (e.button.button == SDL_BUTTON_LEFT)
+                {
+                    activeGame.setSelection(sq == activeGame.getSelection() ? rules::NO_SQUARE : sq);
+                }
+                else if (e.button.button == SDL_BUTTON_RIGHT)
+                {
+                    arrowStart = sq;
                 }
             }
-            else if (e.type == SDL_RENDER_TARGETS_RESET)
+            else if (e.type == SDL_MOUSEBUTTONUP && e.button.button == SDL_BUTTON_RIGHT)
             {
-                // refresh all textures
-                activeGame.redraw(renderer, width, height, MARGIN, GRID_NCOLS, GRID_NROWS);
+                // dragging between two squares draws an arrow; clicking one square clears them
+                rules::Square sq = activeGame.squareAt(e.button.x, e.button.y);
+                if (arrowStart != rules::NO_SQUARE && sq != rules::NO_SQUARE && sq != arrowStart)
+                {
+                    activeGame.addArrow(arrowStart, sq);
+                }
+                else if (sq == arrowStart)
+                {
+                    activeGame.clearArrows();
+                }
+                arrowStart = rules::NO_SQUARE;
             }
             else if (e.type == SDL_QUIT)
             {
                 run = false;
-                break;
             }
         }
 
-        renderer.setDrawColor(BG_COLOR);
-        renderer.clear();
+        invalidated = invalidated || activeGame.needsDisplay();
+        if (run && resizing && static_cast<Sint32>(SDL_GetTicks() - resizeSettled) >= 0)
+        {
+            activeGame.redraw(renderer, width, height, MARGIN, nCols, nRows);
+            resizing = false;
+            invalidated = true;
+        }
+        if (run && invalidated && static_cast<Sint32>(SDL_GetTicks() - nextFrame) >= 0)
+        {
+            if (software)
+            {
+                // draw only the damaged areas, clipped to each, and push only them from the window's surface, which
+                // is what the software renderer draws on
+                sdl::Span<const SDL_Rect> damage = activeGame.collectDamage(width, height);
+                for (SDL_Rect area : damage)
+                {
+                    renderer.setClip(area);
+                    renderer.setDrawColor(BG_COLOR);
+                    renderer.fillRect(area);
+                    activeGame.displayGrid(renderer);
+                    activeGame.displayPieces(renderer);
+                    activeGame.displayOverlay(renderer);
+                }
+                if (!damage.empty())
+                {
+                    renderer.flush();
+                    window.updateSurfaceAreas(damage);
+                }
+            }
+            else
+            {
+                renderer.setDrawColor(BG_COLOR);
+                renderer.clear();
 
-        activeGame.displayGrid(renderer);
+                activeGame.displayGrid(renderer);
+                activeGame.displayPieces(renderer);
+                activeGame.displayOverlay(renderer);
 
-        renderer.present();
+                renderer.present();
+            }
+            invalidated = false;
+            nextFrame = SDL_GetTicks() + frameInterval;
+        }
     }
 
     return 0;
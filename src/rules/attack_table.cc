@@ -0,0 +1,63 @@
+#include "attack_table.hh"
+
+namespace rules
+{
+template <typename BB>
+BasicAttackTable<BB>::BasicAttackTable(const BasicBoardGeometry<BB> &geometry, const std::vector<Offset> &offsets)
+    : squareCount(geometry.getSquareCount()), table(COLOR_COUNT * geometry.getSquareCount()),
+      steps{BasicLeaperSteps<BB>(geometry, offsets, Color::White),
+            BasicLeaperSteps<BB>(geometry, offsets, Color::Black)},
+      lameLeapers(geometry, offsets), riders(geometry, offsets), blockable(!lameLeapers.empty() || !riders.empty()),
+      leapsOnly(true)
+{
+    std::vector<Offset> quietOffsets;
+    bool restricted = false;
+    for (const Offset &offset : offsets)
+    {
+        leapsOnly = leapsOnly && offset.range == 1 && !offset.lame;
+        restricted = restricted || !offset.quiet || !offset.capture;
+        if (offset.quiet)
+        {
+            quietOffsets.push_back(offset);
+            quietOffsets.back().capture = true;
+        }
+    }
+    // the attacks are only the moves that may capture, so a piece with moves that only move or only capture needs a
+    // second table for the moves to empty squares
+    if (restricted)
+    {
+        leapsOnly = false;
+        quiets = std::make_shared<const BasicAttackTable>(geometry, quietOffsets);
+    }
+
+    for (Square from : geometry.getOnBoard())
+    {
+        int x = geometry.xOf(from);
+        int y = geometry.yOf(from);
+        for (const Offset &offset : offsets)
+        {
+            if (offset.range != 1 || offset.lame || !offset.capture || (offset.dx == 0 && offset.dy == 0))
+            {
+                continue;
+            }
+            // white moves forward up the board, black moves forward down it
+            int whiteX = x + offset.dx;
+            int whiteY = y - offset.dy;
+            if (geometry.contains(whiteX, whiteY) && geometry.isEnabled(geometry.squareAt(whiteX, whiteY)))
+            {
+                table[indexOf(Color::White) * squareCount + from].set(geometry.squareAt(whiteX, whiteY));
+            }
+            int blackX = x - offset.dx;
+            int blackY = y + offset.dy;
+            if (geometry.contains(blackX, blackY) && geometry.isEnabled(geometry.squareAt(blackX, blackY)))
+            {
+                table[indexOf(Color::Black) * squareCount + from].set(geometry.squareAt(blackX, blackY));
+            }
+        }
+    }
+}
+
+#define INSTANTIATE(BB) template class BasicAttackTable<BB>;
+RULES_FOR_EACH_BITBOARD(INSTANTIATE)
+#undef INSTANTIATE
+} // namespace rules
@@ -0,0 +1,295 @@
+/**
+ * @file attack_table.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains the BasicAttackTable class template
+ * @date 2026-10-17
+ */
+
+#ifndef RULES_ATTACK_TABLE_HH
+#define RULES_ATTACK_TABLE_HH
+
+#include <array>
+#include <memory>
+#include <rules/bitboard.hh>
+#include <rules/board_geometry.hh>
+#include <rules/lame_leaper_table.hh>
+#include <rules/leaper_steps.hh>
+#include <rules/move.hh>
+#include <rules/rider_table.hh>
+#include <rules/types.hh>
+#include <vector>
+
+namespace rules
+{
+/**
+ * @brief A piece type's moves, compiled for one board into a lookup table of leaper target squares per (color,
+ * square), a BasicLameLeaperTable for its lame leaper moves and a BasicRiderTable for its rider and hopper moves, if
+ * it has any.
+ *
+ * White's forward direction is up the board (-y) and its left is -x; black's are the opposite. Because black's moves
+ * are white's moves rotated 180 degrees, the squares from which a white piece attacks `sq` are exactly the squares a
+ * black piece on `sq` would attack, and vice versa; a rider's or hopper's path is blocked by the same pieces either
+ * way. getAttackers() uses this to answer "who attacks this square" with the same lookup, except for lame leapers,
+ * which have their own.
+ *
+ * The squares a piece attacks are those it could capture on. Moves that may only go to empty squares are compiled
+ * into a second table, used only by pieces that have such moves or capture-only moves.
+ *
+ * @tparam BB the bitboard type of the board
+ */
+template <typename BB> class BasicAttackTable
+{
+  public:
+    /**
+     * @brief Compile a set of relative moves for a board. Moves that would land off the board, or on a disabled
+     * square, are left out of the tables, and moves that cannot capture are left out of all but the quiet moves'.
+     *
+     * @param geometry the board
+     * @param offsets the piece's moves, relative to its square
+     */
+    BasicAttackTable(const BasicBoardGeometry<BB> &geometry, const std::vector<Offset> &offsets);
+
+    /**
+     * @brief Get the squares a piece attacks.
+     *
+     * @param color the piece's color
+     * @param sq the piece's square
+     * @param occupied the occupied squares, which block riders and lame leapers and screen hoppers
+     * @return BB the squares it attacks
+     */
+    BB getAttacks(Color color, Square sq, BB occupied) const
+    {
+        BB attacks = table[indexOf(color) * squareCount + sq];
+        if (blockable)
+        {
+            if (!lameLeapers.empty())
+            {
+                attacks |= lameLeapers.getAttacks(color, sq, occupied);
+            }
+            if (!riders.empty())
+            {
+                attacks |= riders.getAttacks(color, sq, occupied);
+            }
+        }
+        return attacks;
+    }
+    /**
+     * @brief Get the squares a piece may move to: the occupied squares it attacks, and the empty squares its quiet
+     * moves reach. Squares occupied by its own side are included.
+     *
+     * @param color the piece's color
+     * @param sq the piece's square
+     * @param occupied the occupied squares
+     * @return BB the squares it may move to
+     */
+    BB getMoves(Color color, Square sq, BB occupied) const
+    {
+        BB attacks = getAttacks(color, sq, occupied);
+        if (!quiets)
+        {
+            return attacks;
+        }
+        return (attacks & occupied) | quiets->getAttacks(color, sq, occupied).without(occupied);
+    }
+    /**
+     * @brief Get the squares from which a piece of this type would attack `sq`.
+     *
+     * @param attacker the color of the attacking piece
+     * @param sq the attacked square
+     * @param occupied the occupied squares, which block riders and lame leapers and screen hoppers
+     * @return BB the squares it could attack from
+     */
+    BB getAttackers(Color attacker, Square sq, BB occupied) const
+    {
+        BB attackers = table[indexOf(opposite(attacker)) * squareCount + sq];
+        if (blockable)
+        {
+            if (!lameLeapers.empty())
+            {
+                attackers |= lameLeapers.getAttackers(attacker, sq, occupied);
+            }
+            if (!riders.empty())
+            {
+                attackers |= riders.getAttacks(opposite(attacker), sq, occupied);
+            }
+        }
+        return attackers;
+    }
+    /**
+     * @brief Get the squares whose pieces might, by moving away, let a piece of this type attack `sq`: those between
+     * `sq` and its pieces on a rider's line, seeing through every piece but the attackers, the block squares of
+     * lame leaps to `sq` from the attackers, and every square of a hopper's line to `sq`.
+     *
+     * @param attacker the color of the attacking piece
+     * @param sq the attacked square
+     * @param attackers the squares of the attacking side's pieces
+     * @return BB the squares
+     */
+    BB getPinLines(Color attacker, Square sq, BB attackers) const
+    {
+        BB lines;
+        if (!lameLeapers.empty())
+        {
+            lines |= lameLeapers.getBlockSquares(attacker, sq, attackers);
+        }
+        if (!riders.empty())
+        {
+            lines |= riders.getAttacks(opposite(attacker), sq, attackers) | getScreenLines(attacker, sq);
+        }
+        return lines;
+    }
+    /**
+     * @brief Get the squares where a piece, by moving there, might become the screen that lets a hopper of this type
+     * attack `sq`.
+     *
+     * @param attacker the color of the attacking piece
+     * @param sq the attacked square
+     * @return BB the squares of the hoppers' lines to `sq`
+     */
+    BB getScreenLines(Color attacker, Square sq) const
+    {
+        return riders.getHopperRays(opposite(attacker), sq);
+    }
+    /**
+     * @brief Get every square a piece could ever move to from a square, however the other pieces stand: its attacks
+     * and quiet moves on an empty board, and its hoppers' rays.
+     *
+     * @param color the piece's color
+     * @param sq the piece's square
+     * @return BB the squares
+     */
+    BB getReach(Color color, Square sq) const
+    {
+        BB reach = getAttacks(color, sq, BB()) | riders.getHopperRays(color, sq);
+        if (quiets)
+        {
+            reach |= quiets->getReach(color, sq);
+        }
+        return reach;
+    }
+    /**
+     * @brief Check whether other pieces can block or enable the piece's attacks, as they can a rider's, a hopper's
+     * or a lame leaper's.
+     *
+     * @return true some of the piece's attacks depend on other pieces
+     * @return false the piece only attacks by leaping
+     */
+    bool hasBlockableAttacks() const noexcept
+    {
+        return blockable;
+    }
+    /**
+     * @brief Check whether the piece has hopper moves that capture.
+     *
+     * @return true some of the piece's attacks are a hopper's
+     * @return false the piece has no hopper attacks
+     */
+    bool hasHoppers() const noexcept
+    {
+        return riders.hasHoppers();
+    }
+    /**
+     * @brief Generate every move of a set of pieces of this type that lands on one of a set of squares. A few
+     * leapers are looked up in the table one at a time; once there are at least as many leapers as steps, the steps
+     * are used instead. Pieces with any other kind of move are always looked up one at a time.
+     *
+     * @param color the pieces' color
+     * @param pieces the squares of the pieces
+     * @param targets the squares moves may land on
+     * @param occupied the occupied squares, which block riders and lame leapers and screen hoppers
+     * @param moves the list to append the moves to
+     */
+    void generateMoves(Color color, BB pieces, BB targets, BB occupied, MoveList &moves) const
+    {
+        const BasicLeaperSteps<BB> &colorSteps = steps[indexOf(color)];
+        if (leapsOnly && pieces.count() >= colorSteps.getStepCount())
+        {
+            colorSteps.generate(pieces, targets, moves);
+            return;
+        }
+        for (Square from : pieces)
+        {
+            for (Square to : getMoves(color, from, occupied) & targets)
+            {
+                moves.push(Move(from, to));
+            }
+        }
+    }
+    /**
+     * @brief Count the moves generateMoves() would generate, without generating them.
+     *
+     * @param color the pieces' color
+     * @param pieces the squares of the pieces
+     * @param targets the squares moves may land on
+     * @param occupied the occupied squares, which block riders and lame leapers and screen hoppers
+     * @return int the number of moves
+     */
+    int countMoves(Color color, BB pieces, BB targets, BB occupied) const
+    {
+        const BasicLeaperSteps<BB> &colorSteps = steps[indexOf(color)];
+        if (leapsOnly && pieces.count() >= colorSteps.getStepCount())
+        {
+            return colorSteps.count(pieces, targets);
+        }
+        int count = 0;
+        for (Square from : pieces)
+        {
+            count += (getMoves(color, from, occupied) & targets).count();
+        }
+        return count;
+    }
+
+  private:
+    /**
+     * @brief The number of squares per color in `table`.
+     *
+     */
+    int squareCount;
+    /**
+     * @brief The squares attacked by leaper moves, indexed by color and then by square.
+     *
+     */
+    std::vector<BB> table;
+    /**
+     * @brief The moves as whole-board shifts, indexed by color.
+     *
+     */
+    std::array<BasicLeaperSteps<BB>, COLOR_COUNT> steps;
+    /**
+     * @brief The lame leaper moves.
+     *
+     */
+    BasicLameLeaperTable<BB> lameLeapers;
+    /**
+     * @brief The rider and hopper moves.
+     *
+     */
+    BasicRiderTable<BB> riders;
+    /**
+     * @brief The moves to empty squares, or null if they are the same as the attacks. Shared between copies, since
+     * it never changes once compiled.
+     *
+     */
+    std::shared_ptr<const BasicAttackTable> quiets;
+    /**
+     * @brief Whether the piece has lame leaper, rider or hopper attacks. Checked before either table, so that a
+     * leaper's lookups cost one test.
+     *
+     */
+    bool blockable;
+    /**
+     * @brief Whether every move is a leap that may both move and capture, so that the steps can stand in for the
+     * tables.
+     *
+     */
+    bool leapsOnly;
+};
+
+/**
+ * @brief A piece type's moves, compiled for a board of up to 64 squares.
+ *
+ */
+using AttackTable = BasicAttackTable<Bitboard>;
+} // namespace rules
+
+#endif // RULES_ATTACK_TABLE_HH
@@ -0,0 +1,742 @@
+/**
+ * @file bitboard.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains the BasicBitboard class template and its instantiations for each supported board size
+ * @date 2026-10-17
+ */
+
+#ifndef RULES_BITBOARD_HH
+#define RULES_BITBOARD_HH
+
+#include <array>
+#include <cstdint>
+#include <rules/types.hh>
+#include <stdexcept>
+#include <string>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace rules
+{
+/**
+ * @brief A set of squares, stored as one bit per square in `Words` 64-bit words.
+ *
+ * Every operation is a handful of integer instructions, so the members are defined inline here rather than in a
+ * translation unit. The one-word bitboard compiles to plain 64-bit arithmetic. The wider ones use SSE2 for 128 bits
+ * and AVX2 for 256 bits when the compiler targets them, and loops over the words (which the compiler unrolls)
+ * otherwise.
+ *
+ * @tparam Words the number of 64-bit words: 1, 2 or 4
+ */
+template <int Words> class BasicBitboard
+{
+    static_assert(Words == 1 || Words == 2 || Words == 4, "bitboards are 64, 128 or 256 bits");
+
+  public:
+    /**
+     * @brief The number of 64-bit words.
+     *
+     */
+    static constexpr int WORDS = Words;
+    /**
+     * @brief The largest number of squares a bitboard can hold.
+     *
+     */
+    static constexpr int CAPACITY = 64 * Words;
+
+    /**
+     * @brief Iterates over the squares in a bitboard, from lowest to highest.
+     *
+     */
+    class Iterator
+    {
+      public:
+        /**
+         * @brief Construct an iterator over the remaining bits.
+         *
+         * @param words the squares that have not been visited yet
+         */
+        constexpr explicit Iterator(const std::array<std::uint64_t, Words> &words) : words(words), index(0)
+        {
+            skipEmptyWords();
+        }
+        /**
+         * @brief Get the current square.
+         *
+         * @return Square the square
+         */
+        Square operator*() const
+        {
+            return index * 64 + __builtin_ctzll(words[index]);
+        }
+        /**
+         * @brief Advance to the next square.
+         *
+         * @return Iterator& the iterator
+         */
+        Iterator &operator++()
+        {
+            words[index] &= words[index] - 1;
+            skipEmptyWords();
+            return *this;
+        }
+        /**
+         * @brief Compare two iterators.
+         *
+         * @param other the other iterator
+         * @return true the iterators have different squares left
+         * @return false the iterators are equal
+         */
+        constexpr bool operator!=(const Iterator &other) const
+        {
+            if constexpr (Words == 1)
+            {
+                return words[0] != other.words[0];
+            }
+            else
+            {
+                return index != other.index || (index < Words && words[index] != other.words[index]);
+            }
+        }
+
+      private:
+        /**
+         * @brief Move `index` past any words with no squares left. The one-word iterator ends when its word is empty,
+         * so it never moves.
+         *
+         */
+        constexpr void skipEmptyWords()
+        {
+            if constexpr (Words > 1)
+            {
+                while (index < Words && words[index] == 0)
+                {
+                    index++;
+                }
+            }
+        }
+
+        /**
+         * @brief The squares that have not been visited yet.
+         *
+         */
+        std::array<std::uint64_t, Words> words;
+        /**
+         * @brief The word holding the current square, or `Words` at the end.
+         *
+         */
+        int index;
+    };
+
+    /**
+     * @brief Construct an empty bitboard.
+     *
+     */
+    constexpr BasicBitboard() : words()
+    {
+    }
+    /**
+     * @brief Construct a bitboard from the raw bits of its first 64 squares.
+     *
+     * @param bits bit `n` is set if square `n` is in the set
+     */
+    constexpr explicit BasicBitboard(std::uint64_t bits) : words()
+    {
+        words[0] = bits;
+    }
+
+    /**
+     * @brief Create a bitboard holding a single square.
+     *
+     * @param sq the square
+     * @return BasicBitboard the bitboard
+     */
+    static constexpr BasicBitboard fromSquare(Square sq)
+    {
+        BasicBitboard bitboard;
+        bitboard.set(sq);
+        return bitboard;
+    }
+    /**
+     * @brief Create a bitboard holding the first `count` squares.
+     *
+     * @param count the number of squares, at most CAPACITY
+     * @return BasicBitboard the bitboard
+     */
+    static constexpr BasicBitboard firstSquares(int count)
+    {
+        BasicBitboard bitboard;
+        for (int i = 0; i < Words; i++)
+        {
+            int bits = count - i * 64;
+            bitboard.words[i] = bits >= 64 ? ~std::uint64_t{0} : bits <= 0 ? 0 : (std::uint64_t{1} << bits) - 1;
+        }
+        return bitboard;
+    }
+
+    /**
+     * @brief Get one word of the raw bits.
+     *
+     * @param i the word, less than WORDS
+     * @return std::uint64_t bit `n` is set if square `64 * i + n` is in the set
+     */
+    constexpr std::uint64_t getWord(int i) const
+    {
+        return words[i];
+    }
+    /**
+     * @brief Check whether a square is in the set.
+     *
+     * @param sq the square
+     * @return true the square is in the set
+     * @return false the square is not in the set
+     */
+    constexpr bool test(Square sq) const
+    {
+        return ((words[sq >> 6] >> (sq & 63)) & 1) != 0;
+    }
+    /**
+     * @brief Add a square to the set.
+     *
+     * @param sq the square
+     */
+    constexpr void set(Square sq)
+    {
+        words[sq >> 6] |= std::uint64_t{1} << (sq & 63);
+    }
+    /**
+     * @brief Remove a square from the set.
+     *
+     * @param sq the square
+     */
+    constexpr void reset(Square sq)
+    {
+        words[sq >> 6] &= ~(std::uint64_t{1} << (sq & 63));
+    }
+    /**
+     * @brief Check whether the set is empty.
+     *
+     * @return true no squares are set
+     * @return false at least one square is set
+     */
+    bool empty() const
+    {
+#if defined(__AVX2__)
+        if constexpr (Words == 4)
+        {
+            __m256i v = load256();
+            return _mm256_testz_si256(v, v) != 0;
+        }
+#endif
+        std::uint64_t any = 0;
+        for (int i = 0; i < Words; i++)
+        {
+            any |= words[i];
+        }
+        return any == 0;
+    }
+    /**
+     * @brief Count the squares in the set.
+     *
+     * @return int the number of squares
+     */
+    int count() const
+    {
+        // one popcnt per word beats a vector popcount at these widths
+        int total = 0;
+        for (int i = 0; i < Words; i++)
+        {
+            total += __builtin_popcountll(words[i]);
+        }
+        return total;
+    }
+    /**
+     * @brief Get the lowest square in the set. The set must not be empty.
+     *
+     * @return Square the lowest square
+     */
+    Square lowest() const
+    {
+        int i = 0;
+        while (words[i] == 0)
+        {
+            i++;
+        }
+        return i * 64 + __builtin_ctzll(words[i]);
+    }
+    /**
+     * @brief Get the highest square in the set. The set must not be empty.
+     *
+     * @return Square the highest square
+     */
+    Square highest() const
+    {
+        int i = Words - 1;
+        while (words[i] == 0)
+        {
+            i--;
+        }
+        return i * 64 + 63 - __builtin_clzll(words[i]);
+    }
+    /**
+     * @brief Remove the lowest square from the set and return it. The set must not be empty.
+     *
+     * @return Square the square that was removed
+     */
+    Square popLowest()
+    {
+        int i = 0;
+        while (words[i] == 0)
+        {
+            i++;
+        }
+        Square sq = i * 64 + __builtin_ctzll(words[i]);
+        words[i] &= words[i] - 1;
+        return sq;
+    }
+
+    /**
+     * @brief Get an iterator to the lowest square.
+     *
+     * @return Iterator the iterator
+     */
+    constexpr Iterator begin() const
+    {
+        return Iterator(words);
+    }
+    /**
+     * @brief Get the past-the-end iterator.
+     *
+     * @return Iterator the iterator
+     */
+    constexpr Iterator end() const
+    {
+        return Iterator(std::array<std::uint64_t, Words>{});
+    }
+
+    /**
+     * @brief Intersect two sets.
+     *
+     * @param other the other set
+     * @return BasicBitboard the squares in both sets
+     */
+    BasicBitboard operator&(BasicBitboard other) const
+    {
+        return apply<Op::And>(*this, other);
+    }
+    /**
+     * @brief Unite two sets.
+     *
+     * @param other the other set
+     * @return BasicBitboard the squares in either set
+     */
+    BasicBitboard operator|(BasicBitboard other) const
+    {
+        return apply<Op::Or>(*this, other);
+    }
+    /**
+     * @brief Take the symmetric difference of two sets.
+     *
+     * @param other the other set
+     * @return BasicBitboard the squares in exactly one of the sets
+     */
+    BasicBitboard operator^(BasicBitboard other) const
+    {
+        return apply<Op::Xor>(*this, other);
+    }
+    /**
+     * @brief Remove the squares of another set from this one.
+     *
+     * @param other the other set
+     * @return BasicBitboard the squares in this set but not the other
+     */
+    BasicBitboard without(BasicBitboard other) const
+    {
+        return apply<Op::AndNot>(*this, other);
+    }
+    /**
+     * @brief Complement the set. Note that this also sets the bits past the end of the board, so the result should
+     * usually be masked with the board's on-board squares.
+     *
+     * @return BasicBitboard the squares not in this set
+     */
+    BasicBitboard operator~() const
+    {
+        return apply<Op::Xor>(*this, BasicBitboard::firstSquares(CAPACITY));
+    }
+    /**
+     * @brief Shift every square up by `n` squares. Squares shifted past CAPACITY are lost.
+     *
+     * @param n the number of squares, less than CAPACITY
+     * @return BasicBitboard the shifted set
+     */
+    BasicBitboard operator<<(int n) const
+    {
+        if constexpr (Words == 1)
+        {
+            return BasicBitboard(words[0] << n);
+        }
+#if defined(__SSE2__)
+        if constexpr (Words == 2)
+        {
+            if (n < 64)
+            {
+                // each word takes the bits shifted out of the top of the word below it
+                __m128i v = load128();
+                __m128i carry = _mm_srl_epi64(_mm_slli_si128(v, 8), _mm_cvtsi32_si128(64 - n));
+                return store128(_mm_or_si128(_mm_sll_epi64(v, _mm_cvtsi32_si128(n)), carry));
+            }
+        }
+#endif
+#if defined(__AVX2__)
+        if constexpr (Words == 4)
+        {
+            if (n < 64)
+            {
+                __m256i v = load256();
+                __m256i below = _mm256_blend_epi32(_mm256_permute4x64_epi64(v, _MM_SHUFFLE(2, 1, 0, 3)),
+                                                   _mm256_setzero_si256(), 0x03);
+                __m256i carry = _mm256_srl_epi64(below, _mm_cvtsi32_si128(64 - n));
+                return store256(_mm256_or_si256(_mm256_sll_epi64(v, _mm_cvtsi32_si128(n)), carry));
+            }
+        }
+#endif
+        BasicBitboard result;
+        int wordShift = n >> 6;
+        int bitShift = n & 63;
+        for (int i = Words - 1; i >= wordShift; i--)
+        {
+            std::uint64_t word = words[i - wordShift] << bitShift;
+            if (bitShift != 0 && i - wordShift > 0)
+            {
+                word |= words[i - wordShift - 1] >> (64 - bitShift);
+            }
+            result.words[i] = word;
+        }
+        return result;
+    }
+    /**
+     * @brief Shift every square down by `n` squares. Squares shifted below 0 are lost.
+     *
+     * @param n the number of squares, less than CAPACITY
+     * @return BasicBitboard the shifted set
+     */
+    BasicBitboard operator>>(int n) const
+    {
+        if constexpr (Words == 1)
+        {
+            return BasicBitboard(words[0] >> n);
+        }
+#if defined(__SSE2__)
+        if constexpr (Words == 2)
+        {
+            if (n < 64)
+            {
+                // each word takes the bits shifted out of the bottom of the word above it
+                __m128i v = load128();
+                __m128i carry = _mm_sll_epi64(_mm_srli_si128(v, 8), _mm_cvtsi32_si128(64 - n));
+                return store128(_mm_or_si128(_mm_srl_epi64(v, _mm_cvtsi32_si128(n)), carry));
+            }
+        }
+#endif
+#if defined(__AVX2__)
+        if constexpr (Words == 4)
+        {
+            if (n < 64)
+            {
+                __m256i v = load256();
+                __m256i above = _mm256_blend_epi32(_mm256_permute4x64_epi64(v, _MM_SHUFFLE(0, 3, 2, 1)),
+                                                   _mm256_setzero_si256(), 0xc0);
+                __m256i carry = _mm256_sll_epi64(above, _mm_cvtsi32_si128(64 - n));
+                return store256(_mm256_or_si256(_mm256_srl_epi64(v, _mm_cvtsi32_si128(n)), carry));
+            }
+        }
+#endif
+        BasicBitboard result;
+        int wordShift = n >> 6;
+        int bitShift = n & 63;
+        for (int i = 0; i + wordShift < Words; i++)
+        {
+            std::uint64_t word = words[i + wordShift] >> bitShift;
+            if (bitShift != 0 && i + wordShift + 1 < Words)
+            {
+                word |= words[i + wordShift + 1] << (64 - bitShift);
+            }
+            result.words[i] = word;
+        }
+        return result;
+    }
+    /**
+     * @brief Intersect this set with another.
+     *
+     * @param other the other set
+     * @return BasicBitboard& this set
+     */
+    BasicBitboard &operator&=(BasicBitboard other)
+    {
+        return *this = *this & other;
+    }
+    /**
+     * @brief Unite this set with another.
+     *
+     * @param other the other set
+     * @return BasicBitboard& this set
+     */
+    BasicBitboard &operator|=(BasicBitboard other)
+    {
+        return *this = *this | other;
+    }
+    /**
+     * @brief Toggle the squares of another set in this set.
+     *
+     * @param other the other set
+     * @return BasicBitboard& this set
+     */
+    BasicBitboard &operator^=(BasicBitboard other)
+    {
+        return *this = *this ^ other;
+    }
+    /**
+     * @brief Compare two sets.
+     *
+     * @param other the other set
+     * @return true the sets hold the same squares
+     * @return false the sets differ
+     */
+    bool operator==(BasicBitboard other) const
+    {
+        return (*this ^ other).empty();
+    }
+    /**
+     * @brief Compare two sets.
+     *
+     * @param other the other set
+     * @return true the sets differ
+     * @return false the sets hold the same squares
+     */
+    bool operator!=(BasicBitboard other) const
+    {
+        return !(*this == other);
+    }
+
+  private:
+    /**
+     * @brief A bitwise operation on two sets.
+     *
+     */
+    enum class Op
+    {
+        And,
+        Or,
+        Xor,
+        AndNot
+    };
+
+    /**
+     * @brief Apply a bitwise operation to two sets, a whole vector register at a time where possible.
+     *
+     * @tparam op the operation
+     * @param a the left operand
+     * @param b the right operand
+     * @return BasicBitboard the result
+     */
+    template <Op op> static BasicBitboard apply(const BasicBitboard &a, const BasicBitboard &b)
+    {
+#if defined(__SSE2__)
+        if constexpr (Words == 2)
+        {
+            __m128i x = a.load128();
+            __m128i y = b.load128();
+            if constexpr (op == Op::And)
+            {
+                return store128(_mm_and_si128(x, y));
+            }
+            else if constexpr (op == Op::Or)
+            {
+                return store128(_mm_or_si128(x, y));
+            }
+            else if constexpr (op == Op::Xor)
+            {
+                return store128(_mm_xor_si128(x, y));
+            }
+            else
+            {
+                return store128(_mm_andnot_si128(y, x));
+            }
+        }
+#endif
+#if defined(__AVX2__)
+        if constexpr (Words == 4)
+        {
+            __m256i x = a.load256();
+            __m256i y = b.load256();
+            if constexpr (op == Op::And)
+            {
+                return store256(_mm256_and_si256(x, y));
+            }
+            else if constexpr (op == Op::Or)
+            {
+                return store256(_mm256_or_si256(x, y));
+            }
+            else if constexpr (op == Op::Xor)
+            {
+                return store256(_mm256_xor_si256(x, y));
+            }
+            else
+            {
+                return store256(_mm256_andnot_si256(y, x));
+            }
+        }
+#endif
+        BasicBitboard result;
+        for (int i = 0; i < Words; i++)
+        {
+            if constexpr (op == Op::And)
+            {
+                result.words[i] = a.words[i] & b.words[i];
+            }
+            else if constexpr (op == Op::Or)
+            {
+                result.words[i] = a.words[i] | b.words[i];
+            }
+            else if constexpr (op == Op::Xor)
+            {
+                result.words[i] = a.words[i] ^ b.words[i];
+            }
+            else
+            {
+                result.words[i] = a.words[i] & ~b.words[i];
+            }
+        }
+        return result;
+    }
+
+#if defined(__SSE2__)
+    /**
+     * @brief Load the words into an SSE2 register. Only for 128-bit bitboards.
+     *
+     * @return __m128i the register
+     */
+    __m128i load128() const
+    {
+        return _mm_load_si128(reinterpret_cast<const __m128i *>(words.data()));
+    }
+    /**
+     * @brief Create a bitboard from an SSE2 register. Only for 128-bit bitboards.
+     *
+     * @param v the register
+     * @return BasicBitboard the bitboard
+     */
+    static BasicBitboard store128(__m128i v)
+    {
+        BasicBitboard result;
+        _mm_store_si128(reinterpret_cast<__m128i *>(result.words.data()), v);
+        return result;
+    }
+#endif
+#if defined(__AVX2__)
+    /**
+     * @brief Load the words into an AVX2 register. Only for 256-bit bitboards.
+     *
+     * @return __m256i the register
+     */
+    __m256i load256() const
+    {
+        return _mm256_load_si256(reinterpret_cast<const __m256i *>(words.data()));
+    }
+    /**
+     * @brief Create a bitboard from an AVX2 register. Only for 256-bit bitboards.
+     *
+     * @param v the register
+     * @return BasicBitboard the bitboard
+     */
+    static BasicBitboard store256(__m256i v)
+    {
+        BasicBitboard result;
+        _mm256_store_si256(reinterpret_cast<__m256i *>(result.words.data()), v);
+        return result;
+    }
+#endif
+
+    /**
+     * @brief Bit `n` of word `i` is set if square `64 * i + n` is in the set. Aligned to its size so that it can be
+     * loaded into a vector register in one instruction.
+     *
+     */
+    alignas(8 * Words) std::array<std::uint64_t, Words> words;
+};
+
+/**
+ * @brief A bitboard for boards of up to 64 squares, e.g. 8x8.
+ *
+ */
+using Bitboard = BasicBitboard<1>;
+/**
+ * @brief A bitboard for boards of up to 128 squares, e.g. 10x10 or 11x11.
+ *
+ */
+using Bitboard128 = BasicBitboard<2>;
+/**
+ * @brief A bitboard for boards of up to 256 squares, e.g. 12x12 or 16x16.
+ *
+ */
+using Bitboard256 = BasicBitboard<4>;
+
+/**
+ * @brief The most squares any supported board can have.
+ *
+ */
+constexpr int MAX_SQUARES = Bitboard256::CAPACITY;
+
+/**
+ * @brief The most squares any supported board can have along one side, which a board one square wide reaches. A move
+ * that goes this far along an axis lands off every board.
+ *
+ */
+constexpr int MAX_BOARD_SIDE = MAX_SQUARES;
+
+/**
+ * @brief Explicitly instantiate a template for every bitboard size. Used at the end of the translation unit that
+ * defines a template's members, so the members are compiled once instead of in every file that uses them.
+ *
+ */
+#define RULES_FOR_EACH_BITBOARD(INSTANTIATE)                                                                          \
+    INSTANTIATE(::rules::Bitboard)                                                                                    \
+    INSTANTIATE(::rules::Bitboard128)                                                                                 \
+    INSTANTIATE(::rules::Bitboard256)
+
+/**
+ * @brief Call a function with a default-constructed bitboard of the smallest size that holds a board. Code templated
+ * on the bitboard type is instantiated for every size, and this picks one of them, so a variant is dispatched once,
+ * when it is loaded, rather than on every operation.
+ *
+ * @tparam F the function's type
+ * @param squareCount the number of squares in the board's rectangle
+ * @param f the function, which must accept any bitboard type and return the same type for each
+ * @return decltype(auto) whatever `f` returns
+ * @throw std::invalid_argument if the board has more than MAX_SQUARES squares
+ */
+template <typename F> decltype(auto) withBitboardFor(int squareCount, F &&f)
+{
+    if (squareCount <= Bitboard::CAPACITY)
+    {
+        return f(Bitboard());
+    }
+    if (squareCount <= Bitboard128::CAPACITY)
+    {
+        return f(Bitboard128());
+    }
+    if (squareCount <= Bitboard256::CAPACITY)
+    {
+        return f(Bitboard256());
+    }
+    throw std::invalid_argument("board has " + std::to_string(squareCount) + " squares, more than the " +
+                                std::to_string(MAX_SQUARES) + " supported");
+}
+} // namespace rules
+
+#endif // RULES_BITBOARD_HH
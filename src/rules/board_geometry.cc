@@ -0,0 +1,82 @@
+#include "board_geometry.hh"
+#include <stdexcept>
+#include <util/util.hh>
+
+namespace rules
+{
+template <typename BB>
+BasicBoardGeometry<BB>::BasicBoardGeometry(int width, int height) : width(width), height(height)
+{
+    if (width <= 0 || height <= 0)
+    {
+        throw std::invalid_argument(util::concat("board size ", width, "x", height, " is empty"));
+    }
+    if (width * height > BB::CAPACITY)
+    {
+        throw std::invalid_argument(util::concat("board size ", width, "x", height, " has more than ",
+                                                 BB::CAPACITY, " squares"));
+    }
+    onBoard = BB::firstSquares(width * height);
+}
+
+template <typename BB> int BasicBoardGeometry<BB>::getWidth() const noexcept
+{
+    return width;
+}
+
+template <typename BB> int BasicBoardGeometry<BB>::getHeight() const noexcept
+{
+    return height;
+}
+
+template <typename BB> int BasicBoardGeometry<BB>::getSquareCount() const noexcept
+{
+    return width * height;
+}
+
+template <typename BB> BB BasicBoardGeometry<BB>::getOnBoard() const noexcept
+{
+    return onBoard;
+}
+
+template <typename BB> bool BasicBoardGeometry<BB>::contains(int x, int y) const noexcept
+{
+    return x >= 0 && x < width && y >= 0 && y < height;
+}
+
+template <typename BB> Square BasicBoardGeometry<BB>::squareAt(int x, int y) const noexcept
+{
+    return y * width + x;
+}
+
+template <typename BB> int BasicBoardGeometry<BB>::xOf(Square sq) const noexcept
+{
+    return sq % width;
+}
+
+template <typename BB> int BasicBoardGeometry<BB>::yOf(Square sq) const noexcept
+{
+    return sq / width;
+}
+
+template <typename BB> bool BasicBoardGeometry<BB>::isEnabled(Square sq) const noexcept
+{
+    return onBoard.test(sq);
+}
+
+template <typename BB> void BasicBoardGeometry<BB>::setEnabled(Square sq, bool enabled) noexcept
+{
+    if (enabled)
+    {
+        onBoard.set(sq);
+    }
+    else
+    {
+        onBoard.reset(sq);
+    }
+}
+
+#define INSTANTIATE(BB) template class BasicBoardGeometry<BB>;
+RULES_FOR_EACH_BITBOARD(INSTANTIATE)
+#undef INSTANTIATE
+} // namespace rules
@@ -0,0 +1,134 @@
+/**
+ * @file board_geometry.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains the BasicBoardGeometry class template
+ * @date 2026-10-17
+ */
+
+#ifndef RULES_BOARD_GEOMETRY_HH
+#define RULES_BOARD_GEOMETRY_HH
+
+#include <rules/bitboard.hh>
+#include <rules/types.hh>
+
+namespace rules
+{
+/**
+ * @brief The shape of a variant's board: its width and height, and which squares of that rectangle are actually on
+ * the board.
+ *
+ * Squares are numbered left to right, then top to bottom, so square `y * width + x` is column `x` of row `y`.
+ *
+ * @tparam BB the bitboard type, which must hold every square of the board's rectangle
+ */
+template <typename BB> class BasicBoardGeometry
+{
+  public:
+    /**
+     * @brief Construct a rectangular board where every square is on the board.
+     *
+     * @param width the number of columns
+     * @param height the number of rows
+     * @throw std::invalid_argument if the board is empty or has more squares than a BB can hold
+     */
+    BasicBoardGeometry(int width, int height);
+
+    /**
+     * @brief Get the number of columns.
+     *
+     * @return int the width
+     */
+    int getWidth() const noexcept;
+    /**
+     * @brief Get the number of rows.
+     *
+     * @return int the height
+     */
+    int getHeight() const noexcept;
+    /**
+     * @brief Get the number of squares in the board's rectangle, including disabled ones.
+     *
+     * @return int the square count
+     */
+    int getSquareCount() const noexcept;
+    /**
+     * @brief Get the squares that exist on this board.
+     *
+     * @return BB the on-board mask
+     */
+    BB getOnBoard() const noexcept;
+
+    /**
+     * @brief Check whether a coordinate lies within the board's rectangle.
+     *
+     * @param x the column
+     * @param y the row
+     * @return true the coordinate is inside the rectangle
+     * @return false the coordinate is outside the rectangle
+     */
+    bool contains(int x, int y) const noexcept;
+    /**
+     * @brief Get the square at a coordinate. The coordinate must lie within the board's rectangle.
+     *
+     * @param x the column
+     * @param y the row
+     * @return Square the square
+     */
+    Square squareAt(int x, int y) const noexcept;
+    /**
+     * @brief Get the column of a square.
+     *
+     * @param sq the square
+     * @return int the column
+     */
+    int xOf(Square sq) const noexcept;
+    /**
+     * @brief Get the row of a square.
+     *
+     * @param sq the square
+     * @return int the row
+     */
+    int yOf(Square sq) const noexcept;
+
+    /**
+     * @brief Check whether a square exists on this board.
+     *
+     * @param sq the square
+     * @return true the square is on the board
+     * @return false the square has been disabled
+     */
+    bool isEnabled(Square sq) const noexcept;
+    /**
+     * @brief Add a square to, or remove it from, the board. Disabled squares are neither drawn nor in play.
+     *
+     * @param sq the square
+     * @param enabled whether the square is on the board
+     */
+    void setEnabled(Square sq, bool enabled) noexcept;
+
+  private:
+    /**
+     * @brief The number of columns.
+     *
+     */
+    int width;
+    /**
+     * @brief The number of rows.
+     *
+     */
+    int height;
+    /**
+     * @brief The squares that exist on this board.
+     *
+     */
+    BB onBoard;
+};
+
+/**
+ * @brief The shape of a board of up to 64 squares.
+ *
+ */
+using BoardGeometry = BasicBoardGeometry<Bitboard>;
+} // namespace rules
+
+#endif // RULES_BOARD_GEOMETRY_HH
@@ -0,0 +1,111 @@
+#include "lame_leaper_table.hh"
+#include <algorithm>
+#include <cstdlib>
+
+namespace rules
+{
+/**
+ * @brief Get the sign of a number.
+ *
+ * @param n the number
+ * @return int -1, 0 or 1
+ */
+static int signOf(int n)
+{
+    return (n > 0) - (n < 0);
+}
+
+template <typename BB>
+BasicLameLeaperTable<BB>::BasicLameLeaperTable(const BasicBoardGeometry<BB> &geometry,
+                                               const std::vector<Offset> &offsets)
+    : squareCount(geometry.getSquareCount())
+{
+    std::vector<std::vector<Gate>> entries(2 * COLOR_COUNT * squareCount);
+    // add a leap to an entry, sharing a gate with the entry's other leaps over the same square
+    auto open = [&](std::size_t entry, Square block, Square square) {
+        auto gate = std::find_if(entries[entry].begin(), entries[entry].end(),
+                                 [&](const Gate &existing) { return existing.block == block; });
+        if (gate == entries[entry].end())
+        {
+            entries[entry].push_back(Gate{block, BB()});
+            gate = entries[entry].end() - 1;
+        }
+        gate->squares.set(square);
+    };
+    for (Color color : {Color::White, Color::Black})
+    {
+        // white moves forward up the board, black moves forward down it
+        int sign = color == Color::White ? 1 : -1;
+        for (const Offset &offset : offsets)
+        {
+            if (!offset.lame || !offset.capture)
+            {
+                continue;
+            }
+            // one square along the longer axis, or diagonally if neither is longer
+            int stepX = std::abs(offset.dx) >= std::abs(offset.dy) ? signOf(offset.dx) : 0;
+            int stepY = std::abs(offset.dy) >= std::abs(offset.dx) ? signOf(offset.dy) : 0;
+            for (Square from : geometry.getOnBoard())
+            {
+                int x = geometry.xOf(from);
+                int y = geometry.yOf(from);
+                int toX = x + sign * offset.dx;
+                int toY = y - sign * offset.dy;
+                if (!geometry.contains(toX, toY) || !geometry.isEnabled(geometry.squareAt(toX, toY)))
+                {
+                    continue;
+                }
+                // the block square lies between the two, so it is on the board
+                Square block = geometry.squareAt(x + sign * stepX, y - sign * stepY);
+                if (!geometry.isEnabled(block))
+                {
+                    continue;
+                }
+                Square to = geometry.squareAt(toX, toY);
+                open(indexOf(color) * squareCount + from, block, to);
+                open((COLOR_COUNT + indexOf(color)) * squareCount + to, block, from);
+            }
+        }
+    }
+
+    for (const std::vector<Gate> &entry : entries)
+    {
+        gateStarts.push_back(static_cast<std::uint32_t>(gates.size()));
+        gates.insert(gates.end(), entry.begin(), entry.end());
+    }
+    gateStarts.push_back(static_cast<std::uint32_t>(gates.size()));
+
+    if constexpr (std::is_same_v<BB, Bitboard>)
+    {
+        auto fits = [](const std::vector<Gate> &entry) {
+            return entry.size() <= static_cast<std::size_t>(OccupancyTable::MAX_INDEX_BITS);
+        };
+        if (!gates.empty() && std::all_of(entries.begin(), entries.end(), fits))
+        {
+            for (std::size_t entry = 0; entry < entries.size(); entry++)
+            {
+                BB mask;
+                for (const Gate &gate : entries[entry])
+                {
+                    mask.set(gate.block);
+                }
+                indexed.add(mask, [&](BB occupied) {
+                    BB squares;
+                    for (const Gate &gate : entries[entry])
+                    {
+                        if (!occupied.test(gate.block))
+                        {
+                            squares |= gate.squares;
+                        }
+                    }
+                    return squares;
+                });
+            }
+        }
+    }
+}
+
+#define INSTANTIATE(BB) template class BasicLameLeaperTable<BB>;
+RULES_FOR_EACH_BITBOARD(INSTANTIATE)
+#undef INSTANTIATE
+} // namespace rules
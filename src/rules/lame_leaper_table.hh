@@ -0,0 +1,173 @@
+/**
+ * @file lame_leaper_table.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains the BasicLameLeaperTable class template
+ * @date 2026-10-17
+ */
+
+#ifndef RULES_LAME_LEAPER_TABLE_HH
+#define RULES_LAME_LEAPER_TABLE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <rules/bitboard.hh>
+#include <rules/board_geometry.hh>
+#include <rules/occupancy_table.hh>
+#include <rules/types.hh>
+#include <type_traits>
+#include <vector>
+
+namespace rules
+{
+/**
+ * @brief A piece type's lame leaper moves, compiled for one board into tables of the squares it attacks given the
+ * pieces on the squares that can block it.
+ *
+ * Unlike a rider's path, a lame leaper's block square is one step from where it starts, not from where it lands, so
+ * the squares from which a piece attacks a square are not simply the squares it would attack from there as the other
+ * color; both are compiled. Each leap is a gate: a block square, and the square the leap lands on while the block
+ * square is empty. On a board of up to 64 squares, the gates from or to each square are looked up in an
+ * OccupancyTable by the pieces on their block squares; on larger boards, or if some square has more gates than a
+ * table can be indexed by, they are checked one at a time.
+ *
+ * @tparam BB the bitboard type of the board
+ */
+template <typename BB> class BasicLameLeaperTable
+{
+  public:
+    /**
+     * @brief Compile a piece's lame leaper moves for a board. Offsets that are not lame or cannot capture are left
+     * out, as are leaps whose block square is disabled, since nothing can ever leave it.
+     *
+     * @param geometry the board
+     * @param offsets the piece's moves, relative to its square
+     */
+    BasicLameLeaperTable(const BasicBoardGeometry<BB> &geometry, const std::vector<Offset> &offsets);
+
+    /**
+     * @brief Check whether the piece has no lame leaper moves.
+     *
+     * @return true the piece has no lame leaper moves
+     * @return false the piece has at least one lame leaper move
+     */
+    bool empty() const noexcept
+    {
+        return gates.empty();
+    }
+    /**
+     * @brief Get the squares a piece attacks with its lame leaps.
+     *
+     * @param color the piece's color
+     * @param sq the piece's square
+     * @param occupied the occupied squares
+     * @return BB the squares it attacks
+     */
+    BB getAttacks(Color color, Square sq, BB occupied) const
+    {
+        return lookUp(indexOf(color) * squareCount + sq, occupied);
+    }
+    /**
+     * @brief Get the squares from which a piece of this type would attack `sq` with its lame leaps.
+     *
+     * @param attacker the color of the attacking piece
+     * @param sq the attacked square
+     * @param occupied the occupied squares
+     * @return BB the squares it could attack from
+     */
+    BB getAttackers(Color attacker, Square sq, BB occupied) const
+    {
+        return lookUp((COLOR_COUNT + indexOf(attacker)) * squareCount + sq, occupied);
+    }
+    /**
+     * @brief Get the block squares of the lame leaps that could land on `sq` from some of a set of squares.
+     *
+     * @param attacker the color of the leaping piece
+     * @param sq the square landed on
+     * @param from the squares the leaps may start from
+     * @return BB the block squares
+     */
+    BB getBlockSquares(Color attacker, Square sq, BB from) const
+    {
+        std::size_t entry = (COLOR_COUNT + indexOf(attacker)) * squareCount + sq;
+        BB blocks;
+        for (std::uint32_t i = gateStarts[entry]; i < gateStarts[entry + 1]; i++)
+        {
+            if (!(gates[i].squares & from).empty())
+            {
+                blocks.set(gates[i].block);
+            }
+        }
+        return blocks;
+    }
+
+  private:
+    /**
+     * @brief A set of leaps that share a block square.
+     *
+     */
+    struct Gate
+    {
+        /**
+         * @brief The square that blocks the leaps when occupied.
+         *
+         */
+        Square block;
+        /**
+         * @brief The squares the leaps land on when it is empty, or start from for the squares a piece attacks from.
+         *
+         */
+        BB squares;
+    };
+
+    /**
+     * @brief Look up the squares that the open gates of an entry lead to.
+     *
+     * @param entry the entry: the gates from a square for a color, or those to a square for the other color
+     * @param occupied the occupied squares
+     * @return BB the squares
+     */
+    BB lookUp(std::size_t entry, BB occupied) const
+    {
+        if constexpr (std::is_same_v<BB, Bitboard>)
+        {
+            if (!indexed.empty())
+            {
+                return indexed.get(entry, occupied);
+            }
+        }
+        BB squares;
+        for (std::uint32_t i = gateStarts[entry]; i < gateStarts[entry + 1]; i++)
+        {
+            if (!occupied.test(gates[i].block))
+            {
+                squares |= gates[i].squares;
+            }
+        }
+        return squares;
+    }
+
+    /**
+     * @brief The number of squares per color in the entries.
+     *
+     */
+    int squareCount;
+    /**
+     * @brief Every entry's gates. The gates from each square are indexed by color and then square, followed by the
+     * gates to each square, indexed the same way.
+     *
+     */
+    std::vector<Gate> gates;
+    /**
+     * @brief The index of each entry's first gate in `gates`, followed by the number of gates.
+     *
+     */
+    std::vector<std::uint32_t> gateStarts;
+    /**
+     * @brief The entries' lookups, or no entries if the gates are checked one at a time.
+     *
+     */
+    OccupancyTable indexed;
+};
+} // namespace rules
+
+#endif // RULES_LAME_LEAPER_TABLE_HH
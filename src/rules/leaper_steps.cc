@@ -0,0 +1,236 @@
+#include "leaper_steps.hh"
+#include <algorithm>
+#include <type_traits>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define RULES_LEAPER_STEPS_AVX2
+#endif
+
+namespace rules
+{
+#if defined(RULES_LEAPER_STEPS_AVX2)
+/**
+ * @brief Check whether the CPU running the program has AVX2.
+ *
+ * @return true the AVX2 kernel can be used
+ * @return false only the scalar steps can be used
+ */
+static bool cpuHasAvx2()
+{
+#if defined(__AVX2__)
+    return true;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+/**
+ * @brief Whether the CPU running the program has AVX2, checked once when the program starts.
+ *
+ */
+static const bool HAS_AVX2 = cpuHasAvx2();
+
+/**
+ * @brief Shift a batch of four of a 64-square board's steps at once. Like the other AVX2 functions, this is compiled
+ * for AVX2 whatever the target of the rest of the program, and must only be called when HAS_AVX2 is set.
+ *
+ * @param sources the squares each step of the batch can be taken from
+ * @param shifts the number of squares each step of the batch moves a piece by
+ * @param pieces the squares of the pieces, in every lane
+ * @param targets the squares moves may land on, in every lane
+ * @return __m256i the squares each step reaches, one step per lane
+ */
+__attribute__((target("avx2"))) static inline __m256i shiftBatch(const Bitboard *sources, const std::int32_t *shifts,
+                                                                 __m256i pieces, __m256i targets)
+{
+    __m256i from = _mm256_and_si256(pieces, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(sources)));
+    // each lane shifts by its own step, left for positive steps and right for negative ones
+    __m128i zero = _mm_setzero_si128();
+    __m128i shift = _mm_loadu_si128(reinterpret_cast<const __m128i *>(shifts));
+    __m256i left = _mm256_cvtepi32_epi64(_mm_max_epi32(shift, zero));
+    __m256i right = _mm256_cvtepi32_epi64(_mm_max_epi32(_mm_sub_epi32(zero, shift), zero));
+    return _mm256_and_si256(_mm256_srlv_epi64(_mm256_sllv_epi64(from, left), right), targets);
+}
+
+/**
+ * @brief Generate the moves of a 64-square board's steps, four steps at a time.
+ *
+ * @param sources the squares each step can be taken from
+ * @param shifts the number of squares each step moves a piece by
+ * @param count the number of steps, a multiple of the batch size
+ * @param pieces the squares of the pieces
+ * @param targets the squares moves may land on
+ * @param moves the list to append the moves to
+ */
+__attribute__((target("avx2"))) static void generateAvx2(const Bitboard *sources, const std::int32_t *shifts,
+                                                         int count, Bitboard pieces, Bitboard targets,
+                                                         MoveList &moves)
+{
+    __m256i piecesV = _mm256_set1_epi64x(static_cast<long long>(pieces.getWord(0)));
+    __m256i targetsV = _mm256_set1_epi64x(static_cast<long long>(targets.getWord(0)));
+    alignas(32) std::uint64_t reached[BasicLeaperSteps<Bitboard>::BATCH_SIZE];
+    for (int i = 0; i < count; i += BasicLeaperSteps<Bitboard>::BATCH_SIZE)
+    {
+        __m256i to = shiftBatch(sources + i, shifts + i, piecesV, targetsV);
+        if (_mm256_testz_si256(to, to))
+        {
+            continue;
+        }
+        _mm256_store_si256(reinterpret_cast<__m256i *>(reached), to);
+        for (int lane = 0; lane < BasicLeaperSteps<Bitboard>::BATCH_SIZE; lane++)
+        {
+            for (Square square : Bitboard(reached[lane]))
+            {
+                moves.push(Move(square - shifts[i + lane], square));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Count the moves of a 64-square board's steps, four steps at a time. The squares reached are counted in
+ * every lane at once by looking up the count of each nibble.
+ *
+ * @param sources the squares each step can be taken from
+ * @param shifts the number of squares each step moves a piece by
+ * @param count the number of steps, a multiple of the batch size
+ * @param pieces the squares of the pieces
+ * @param targets the squares moves may land on
+ * @return int the number of moves
+ */
+__attribute__((target("avx2"))) static int countAvx2(const Bitboard *sources, const std::int32_t *shifts, int count,
+                                                     Bitboard pieces, Bitboard targets)
+{
+    __m256i piecesV = _mm256_set1_epi64x(static_cast<long long>(pieces.getWord(0)));
+    __m256i targetsV = _mm256_set1_epi64x(static_cast<long long>(targets.getWord(0)));
+    __m256i nibbleCounts = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1,
+                                            2, 2, 3, 2, 3, 3, 4);
+    __m256i lowNibbles = _mm256_set1_epi8(0x0f);
+    __m256i total = _mm256_setzero_si256();
+    for (int i = 0; i < count; i += BasicLeaperSteps<Bitboard>::BATCH_SIZE)
+    {
+        __m256i to = shiftBatch(sources + i, shifts + i, piecesV, targetsV);
+        __m256i low = _mm256_shuffle_epi8(nibbleCounts, _mm256_and_si256(to, lowNibbles));
+        __m256i high = _mm256_shuffle_epi8(nibbleCounts, _mm256_and_si256(_mm256_srli_epi16(to, 4), lowNibbles));
+        // summing the byte counts of each lane against zero leaves the lane's count in its low word
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(_mm256_add_epi8(low, high), _mm256_setzero_si256()));
+    }
+    __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(total), _mm256_extracti128_si256(total, 1));
+    return static_cast<int>(_mm_cvtsi128_si64(sum) + _mm_extract_epi64(sum, 1));
+}
+#endif
+
+template <typename BB>
+BasicLeaperSteps<BB>::BasicLeaperSteps(const BasicBoardGeometry<BB> &geometry, const std::vector<Offset> &offsets,
+                                       Color color)
+{
+    int sign = color == Color::White ? 1 : -1;
+    for (Square from : geometry.getOnBoard())
+    {
+        for (const Offset &offset : offsets)
+        {
+            if (offset.range != 1 || offset.lame || !offset.capture || (offset.dx == 0 && offset.dy == 0))
+            {
+                continue;
+            }
+            // white moves forward up the board, black moves forward down it
+            int x = geometry.xOf(from) + sign * offset.dx;
+            int y = geometry.yOf(from) - sign * offset.dy;
+            if (!geometry.contains(x, y) || !geometry.isEnabled(geometry.squareAt(x, y)))
+            {
+                continue;
+            }
+            // two offsets with the same shift can never both be taken from the same square, so they share a step
+            std::int32_t shift = geometry.squareAt(x, y) - from;
+            auto step = std::find(shifts.begin(), shifts.end(), shift);
+            if (step == shifts.end())
+            {
+                shifts.push_back(shift);
+                sources.emplace_back();
+                step = shifts.end() - 1;
+            }
+            sources[step - shifts.begin()].set(from);
+        }
+    }
+    stepCount = static_cast<int>(shifts.size());
+    while (shifts.size() % BATCH_SIZE != 0)
+    {
+        shifts.push_back(0);
+        sources.emplace_back();
+    }
+}
+
+template <typename BB> void BasicLeaperSteps<BB>::generate(BB pieces, BB targets, MoveList &moves) const
+{
+#if defined(RULES_LEAPER_STEPS_AVX2)
+    if constexpr (std::is_same_v<BB, Bitboard>)
+    {
+        if (HAS_AVX2)
+        {
+            generateAvx2(sources.data(), shifts.data(), static_cast<int>(shifts.size()), pieces, targets, moves);
+            return;
+        }
+    }
+#endif
+    generateScalar(pieces, targets, moves);
+}
+
+template <typename BB> int BasicLeaperSteps<BB>::count(BB pieces, BB targets) const
+{
+#if defined(RULES_LEAPER_STEPS_AVX2)
+    if constexpr (std::is_same_v<BB, Bitboard>)
+    {
+        if (HAS_AVX2)
+        {
+            return countAvx2(sources.data(), shifts.data(), static_cast<int>(shifts.size()), pieces, targets);
+        }
+    }
+#endif
+    return countScalar(pieces, targets);
+}
+
+template <typename BB> int BasicLeaperSteps<BB>::getStepCount() const noexcept
+{
+    return stepCount;
+}
+
+template <typename BB> void BasicLeaperSteps<BB>::generateScalar(BB pieces, BB targets, MoveList &moves) const
+{
+    for (std::size_t i = 0; i < shifts.size(); i++)
+    {
+        BB from = pieces & sources[i];
+        if (from.empty())
+        {
+            continue;
+        }
+        std::int32_t shift = shifts[i];
+        BB to = (shift >= 0 ? from << shift : from >> -shift) & targets;
+        for (Square square : to)
+        {
+            moves.push(Move(square - shift, square));
+        }
+    }
+}
+
+template <typename BB> int BasicLeaperSteps<BB>::countScalar(BB pieces, BB targets) const
+{
+    int count = 0;
+    for (std::size_t i = 0; i < shifts.size(); i++)
+    {
+        BB from = pieces & sources[i];
+        if (from.empty())
+        {
+            continue;
+        }
+        std::int32_t shift = shifts[i];
+        count += ((shift >= 0 ? from << shift : from >> -shift) & targets).count();
+    }
+    return count;
+}
+
+#define INSTANTIATE(BB) template class BasicLeaperSteps<BB>;
+RULES_FOR_EACH_BITBOARD(INSTANTIATE)
+#undef INSTANTIATE
+} // namespace rules
@@ -0,0 +1,111 @@
+/**
+ * @file leaper_steps.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains the BasicLeaperSteps class template
+ * @date 2026-10-17
+ */
+
+#ifndef RULES_LEAPER_STEPS_HH
+#define RULES_LEAPER_STEPS_HH
+
+#include <cstdint>
+#include <rules/bitboard.hh>
+#include <rules/board_geometry.hh>
+#include <rules/move.hh>
+#include <rules/types.hh>
+#include <vector>
+
+namespace rules
+{
+/**
+ * @brief A leaper's moves for one color, compiled for one board into whole-board shifts, so that the moves of every
+ * piece of a type are generated together rather than one piece at a time.
+ *
+ * Each of the piece's offsets moves every square by the same number of squares, so the targets of all the pieces on
+ * the squares an offset can leave from are those squares shifted by that number. The offsets are processed one
+ * batch at a time; on a 64-square board with a CPU that has AVX2 (checked when the program starts), the offsets of a
+ * batch are shifted, masked and counted in parallel, one per 64-bit lane.
+ *
+ * @tparam BB the bitboard type of the board
+ */
+template <typename BB> class BasicLeaperSteps
+{
+  public:
+    /**
+     * @brief The number of offsets generated together. The steps are padded to a multiple of this with steps that
+     * no piece can take.
+     *
+     */
+    static constexpr int BATCH_SIZE = 4;
+
+    /**
+     * @brief Compile a set of relative moves for a board. Offsets that move every square by the same amount are
+     * merged into one step. Only plain leaps that may capture are compiled; the other moves are left to
+     * BasicAttackTable.
+     *
+     * @param geometry the board
+     * @param offsets the piece's moves, relative to its square, as white sees them
+     * @param color the color to compile the moves for
+     */
+    BasicLeaperSteps(const BasicBoardGeometry<BB> &geometry, const std::vector<Offset> &offsets, Color color);
+
+    /**
+     * @brief Generate every move of a set of pieces of this type that lands on one of a set of squares.
+     *
+     * @param pieces the squares of the pieces
+     * @param targets the squares moves may land on
+     * @param moves the list to append the moves to
+     */
+    void generate(BB pieces, BB targets, MoveList &moves) const;
+    /**
+     * @brief Count the moves generate() would generate, without generating them.
+     *
+     * @param pieces the squares of the pieces
+     * @param targets the squares moves may land on
+     * @return int the number of moves
+     */
+    int count(BB pieces, BB targets) const;
+    /**
+     * @brief Get the number of distinct steps, not counting the padding.
+     *
+     * @return int the step count
+     */
+    int getStepCount() const noexcept;
+
+  private:
+    /**
+     * @brief Generate moves one step at a time, with the bitboard's own shifts.
+     *
+     * @param pieces the squares of the pieces
+     * @param targets the squares moves may land on
+     * @param moves the list to append the moves to
+     */
+    void generateScalar(BB pieces, BB targets, MoveList &moves) const;
+    /**
+     * @brief Count moves one step at a time, with the bitboard's own shifts.
+     *
+     * @param pieces the squares of the pieces
+     * @param targets the squares moves may land on
+     * @return int the number of moves
+     */
+    int countScalar(BB pieces, BB targets) const;
+
+    /**
+     * @brief The squares each step can be taken from: those whose target is on the board.
+     *
+     */
+    std::vector<BB> sources;
+    /**
+     * @brief The number of squares each step moves a piece by; positive steps move up the board's square order.
+     *
+     */
+    std::vector<std::int32_t> shifts;
+    /**
+     * @brief The number of distinct steps, not counting the padding.
+     *
+     */
+    int stepCount;
+};
+} // namespace rules
+
+#endif // RULES_LEAPER_STEPS_HH
@@ -0,0 +1,257 @@
+/**
+ * @file move.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains the Move and MoveList classes
+ * @date 2026-10-17
+ */
+
+#ifndef RULES_MOVE_HH
+#define RULES_MOVE_HH
+
+#include <array>
+#include <cstdint>
+#include <rules/types.hh>
+#include <stdexcept>
+
+namespace rules
+{
+/**
+ * @brief A move of a piece from one square to another, packed into 16 bits.
+ *
+ */
+class Move
+{
+  public:
+    /**
+     * @brief Construct the null move, which is not a valid move in any position.
+     *
+     */
+    constexpr Move() : data(0)
+    {
+    }
+    /**
+     * @brief Construct a move.
+     *
+     * @param from the square the piece moves from
+     * @param to the square the piece moves to
+     */
+    constexpr Move(Square from, Square to)
+        : data(static_cast<std::uint16_t>(static_cast<unsigned>(from) | (static_cast<unsigned>(to) << 8)))
+    {
+    }
+
+    /**
+     * @brief Recreate a move from the bits returned by getBits().
+     *
+     * @param bits the bits
+     * @return Move the move
+     */
+    static constexpr Move fromBits(std::uint16_t bits)
+    {
+        Move move;
+        move.data = bits;
+        return move;
+    }
+    /**
+     * @brief Get the move packed into 16 bits, for storing it compactly.
+     *
+     * @return std::uint16_t the bits
+     */
+    constexpr std::uint16_t getBits() const
+    {
+        return data;
+    }
+
+    /**
+     * @brief Get the square the piece moves from.
+     *
+     * @return Square the square
+     */
+    constexpr Square getFrom() const
+    {
+        return data & 0xff;
+    }
+    /**
+     * @brief Get the square the piece moves to.
+     *
+     * @return Square the square
+     */
+    constexpr Square getTo() const
+    {
+        return data >> 8;
+    }
+    /**
+     * @brief Check whether this is the null move.
+     *
+     * @return true this is the null move
+     * @return false this is a real move
+     */
+    constexpr bool isNull() const
+    {
+        return data == 0;
+    }
+    /**
+     * @brief Compare two moves.
+     *
+     * @param other the other move
+     * @return true the moves are the same
+     * @return false the moves differ
+     */
+    constexpr bool operator==(Move other) const
+    {
+        return data == other.data;
+    }
+    /**
+     * @brief Compare two moves.
+     *
+     * @param other the other move
+     * @return true the moves differ
+     * @return false the moves are the same
+     */
+    constexpr bool operator!=(Move other) const
+    {
+        return data != other.data;
+    }
+
+  private:
+    /**
+     * @brief The from square in the low byte and the to square in the high byte.
+     *
+     */
+    std::uint16_t data;
+};
+
+/**
+ * @brief A fixed-capacity list of moves, so that generating moves never allocates.
+ *
+ */
+class MoveList
+{
+  public:
+    /**
+     * @brief The most moves a list can hold.
+     *
+     */
+    static constexpr int CAPACITY = 1024;
+
+    /**
+     * @brief Construct an empty list.
+     *
+     */
+    MoveList() : size_(0)
+    {
+    }
+
+    /**
+     * @brief Append a move.
+     *
+     * @param move the move
+     * @throw std::length_error if the list is full
+     */
+    void push(Move move)
+    {
+        if (size_ == CAPACITY)
+        {
+            throw std::length_error("move list is full");
+        }
+        moves[size_++] = move;
+    }
+    /**
+     * @brief Remove every move from the list.
+     *
+     */
+    void clear()
+    {
+        size_ = 0;
+    }
+    /**
+     * @brief Get the number of moves in the list.
+     *
+     * @return int the size
+     */
+    int size() const
+    {
+        return size_;
+    }
+    /**
+     * @brief Check whether the list is empty.
+     *
+     * @return true there are no moves
+     * @return false there is at least one move
+     */
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+    /**
+     * @brief Get a move by index.
+     *
+     * @param i the index
+     * @return Move& the move
+     */
+    Move &operator[](int i)
+    {
+        return moves[i];
+    }
+    /**
+     * @brief Get a move by index.
+     *
+     * @param i the index
+     * @return Move the move
+     */
+    Move operator[](int i) const
+    {
+        return moves[i];
+    }
+    /**
+     * @brief Get a pointer to the first move.
+     *
+     * @return Move* the first move
+     */
+    Move *begin()
+    {
+        return moves.data();
+    }
+    /**
+     * @brief Get a pointer past the last move.
+     *
+     * @return Move* past the last move
+     */
+    Move *end()
+    {
+        return moves.data() + size_;
+    }
+    /**
+     * @brief Get a pointer to the first move.
+     *
+     * @return const Move* the first move
+     */
+    const Move *begin() const
+    {
+        return moves.data();
+    }
+    /**
+     * @brief Get a pointer past the last move.
+     *
+     * @return const Move* past the last move
+     */
+    const Move *end() const
+    {
+        return moves.data() + size_;
+    }
+
+  private:
+    /**
+     * @brief The storage for the moves. Only the first `size_` are valid.
+     *
+     */
+    std::array<Move, CAPACITY> moves;
+    /**
+     * @brief The number of moves in the list.
+     *
+     */
+    int size_;
+};
+} // namespace rules
+
+#endif // RULES_MOVE_HH
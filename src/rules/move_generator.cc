@@ -0,0 +1,267 @@
+#include "move_generator.hh"
+#include <algorithm>
+
+namespace rules
+{
+/**
+ * @brief Find the pieces of one side that would attack a square if a different set of squares were occupied, as
+ * they are after a move.
+ *
+ * @param variant the rules being played
+ * @param position the position
+ * @param sq the attacked square
+ * @param attacker the side whose pieces are attacking
+ * @param occupied the squares to treat as occupied, which block riders and lame leapers and screen hoppers
+ * @return BB the squares of the attacking pieces
+ */
+template <typename BB>
+static BB getAttackersWith(const BasicVariant<BB> &variant, const BasicPosition<BB> &position, Square sq,
+                           Color attacker, BB occupied)
+{
+    BB attackers;
+    for (PieceType type = 0; type < variant.getPieceTypeCount(); type++)
+    {
+        attackers |=
+            variant.getAttackTable(type).getAttackers(attacker, sq, occupied) & position.getPieces(attacker, type);
+    }
+    return attackers;
+}
+
+template <typename BB>
+BB getAttackers(const BasicVariant<BB> &variant, const BasicPosition<BB> &position, Square sq, Color attacker)
+{
+    return getAttackersWith(variant, position, sq, attacker, position.getOccupied());
+}
+
+template <typename BB> bool isInCheck(const BasicVariant<BB> &variant, const BasicPosition<BB> &position, Color color)
+{
+    Square crown = position.getCrown(color);
+    return crown != NO_SQUARE && !getAttackers(variant, position, crown, opposite(color)).empty();
+}
+
+template <typename BB>
+void generatePseudoLegalMoves(const BasicVariant<BB> &variant, const BasicPosition<BB> &position, MoveList &moves)
+{
+    Color us = position.getSideToMove();
+    BB notOurs = ~position.getPieces(us);
+    BB occupied = position.getOccupied();
+    for (PieceType type = 0; type < variant.getPieceTypeCount(); type++)
+    {
+        variant.getAttackTable(type).generateMoves(us, position.getPieces(us, type), notOurs, occupied, moves);
+    }
+}
+
+/**
+ * @brief Split the legal moves for the side to move that land on one of a set of squares into sets of pieces of one
+ * type and the squares they may move to, so that each set's moves can be generated or counted together.
+ *
+ * @tparam Visit the type of the visitor
+ * @param variant the rules being played
+ * @param position the position
+ * @param targets the squares moves may land on
+ * @param visit called with a piece type's attack table, the squares of some of the side to move's pieces of that
+ * type, and the squares those pieces may legally move to
+ */
+template <typename BB, typename Visit>
+static void visitLegalMoves(const BasicVariant<BB> &variant, const BasicPosition<BB> &position, BB targets,
+                            Visit &&visit)
+{
+    Color us = position.getSideToMove();
+    Color them = opposite(us);
+    Square crown = position.getCrown(us);
+    BB occupied = position.getOccupied();
+    BB notOurs = ~position.getPieces(us) & targets;
+    if (crown == NO_SQUARE)
+    {
+        for (PieceType type = 0; type < variant.getPieceTypeCount(); type++)
+        {
+            visit(variant.getAttackTable(type), position.getPieces(us, type), notOurs);
+        }
+        return;
+    }
+
+    BB checkers = getAttackers(variant, position, crown, them);
+    BB crownSquare = BB::fromSquare(crown);
+    if (!variant.hasBlockableAttacks())
+    {
+        // Every piece attacks by leaping, so pieces cannot block or pin each other. A move by anything but the crown
+        // can only change whether the crown is attacked by capturing the one piece attacking it.
+        BB nonCrownTargets = notOurs;
+        if (checkers.count() > 1)
+        {
+            nonCrownTargets = BB();
+        }
+        else if (!checkers.empty())
+        {
+            nonCrownTargets &= checkers;
+        }
+        if (!nonCrownTargets.empty())
+        {
+            for (PieceType type = 0; type < variant.getPieceTypeCount(); type++)
+            {
+                visit(variant.getAttackTable(type), position.getPieces(us, type).without(crownSquare),
+                      nonCrownTargets);
+            }
+        }
+    }
+    else
+    {
+        // visit the moves of one piece to some of the squares, keeping only the legal ones
+        auto visitTried = [&](Square from, BB candidates) {
+            const BasicAttackTable<BB> &table = variant.getAttackTable(position.getTypeAt(from));
+            BB legalTargets;
+            for (Square to : table.getMoves(us, from, occupied) & candidates)
+            {
+                if (isLegal(variant, position, Move(from, to)))
+                {
+                    legalTargets.set(to);
+                }
+            }
+            visit(table, BB::fromSquare(from), legalTargets);
+        };
+
+        // A piece may block, pin or screen another's attacks. Only the pieces that might expose the crown by moving
+        // away can be pinned: those on a line from the crown to an enemy rider, looking through our own pieces, on
+        // the block square of a lame leap from an enemy piece to the crown, or on a hopper's line to the crown. Their
+        // moves, moves onto a hopper's line, which might give it a screen, and every move while in check are tried
+        // one at a time.
+        BB tried = position.getPieces(us).without(crownSquare);
+        if (checkers.empty())
+        {
+            BB theirs = position.getPieces(them);
+            BB lines;
+            BB screenLines;
+            for (PieceType type = 0; type < variant.getPieceTypeCount(); type++)
+            {
+                const BasicAttackTable<BB> &table = variant.getAttackTable(type);
+                if (table.hasBlockableAttacks() && !position.getPieces(them, type).empty())
+                {
+                    lines |= table.getPinLines(them, crown, theirs);
+                    if (table.hasHoppers())
+                    {
+                        screenLines |= table.getScreenLines(them, crown);
+                    }
+                }
+            }
+            tried &= lines;
+            for (PieceType type = 0; type < variant.getPieceTypeCount(); type++)
+            {
+                visit(variant.getAttackTable(type), position.getPieces(us, type).without(tried | crownSquare),
+                      notOurs.without(screenLines));
+            }
+            if (!screenLines.empty())
+            {
+                for (Square from : position.getPieces(us).without(tried | crownSquare))
+                {
+                    visitTried(from, notOurs & screenLines);
+                }
+            }
+        }
+        for (Square from : tried)
+        {
+            visitTried(from, notOurs);
+        }
+    }
+
+    // the crown's own square no longer blocks anything once it moves
+    const BasicAttackTable<BB> &crownTable = variant.getAttackTable(position.getTypeAt(crown));
+    BB vacated = occupied.without(crownSquare);
+    BB crownTargets;
+    for (Square to : crownTable.getMoves(us, crown, occupied) & notOurs)
+    {
+        if (getAttackersWith(variant, position, to, them, vacated).empty())
+        {
+            crownTargets.set(to);
+        }
+    }
+    visit(crownTable, crownSquare, crownTargets);
+}
+
+template <typename BB>
+void generateLegalMoves(const BasicVariant<BB> &variant, const BasicPosition<BB> &position, MoveList &moves)
+{
+    Color us = position.getSideToMove();
+    BB occupied = position.getOccupied();
+    visitLegalMoves(variant, position, variant.getGeometry().getOnBoard(),
+                    [&](const BasicAttackTable<BB> &table, BB pieces, BB targets) {
+                        table.generateMoves(us, pieces, targets, occupied, moves);
+                    });
+}
+
+template <typename BB> int countLegalMoves(const BasicVariant<BB> &variant, const BasicPosition<BB> &position)
+{
+    Color us = position.getSideToMove();
+    BB occupied = position.getOccupied();
+    int count = 0;
+    visitLegalMoves(variant, position, variant.getGeometry().getOnBoard(),
+                    [&](const BasicAttackTable<BB> &table, BB pieces, BB targets) {
+                        count += table.countMoves(us, pieces, targets, occupied);
+                    });
+    return count;
+}
+
+template <typename BB>
+void generateLegalCaptures(const BasicVariant<BB> &variant, const BasicPosition<BB> &position, MoveList &moves)
+{
+    Color us = position.getSideToMove();
+    BB occupied = position.getOccupied();
+    visitLegalMoves(variant, position, position.getPieces(opposite(us)),
+                    [&](const BasicAttackTable<BB> &table, BB pieces, BB targets) {
+                        table.generateMoves(us, pieces, targets, occupied, moves);
+                    });
+}
+
+template <typename BB> bool isLegal(const BasicVariant<BB> &variant, const BasicPosition<BB> &position, Move move)
+{
+    Color us = position.getSideToMove();
+    Square crown = position.getCrown(us);
+    if (crown == NO_SQUARE)
+    {
+        return true;
+    }
+    Square from = move.getFrom();
+    Square to = move.getTo();
+    BB occupied = position.getOccupied().without(BB::fromSquare(from)) | BB::fromSquare(to);
+    // a piece captured on `to` no longer attacks anything
+    BB attackers = getAttackersWith(variant, position, from == crown ? to : crown, opposite(us), occupied);
+    return attackers.without(BB::fromSquare(to)).empty();
+}
+
+template <typename BB> int maxPseudoLegalMoves(const BasicVariant<BB> &variant, const BasicPosition<BB> &position)
+{
+    const BasicBoardGeometry<BB> &geometry = variant.getGeometry();
+    int most = 0;
+    for (Color color : {Color::White, Color::Black})
+    {
+        int total = 0;
+        for (PieceType type = 0; type < variant.getPieceTypeCount(); type++)
+        {
+            int pieces = position.getPieces(color, type).count();
+            if (pieces == 0)
+            {
+                continue;
+            }
+            int reach = 0;
+            for (Square sq : geometry.getOnBoard())
+            {
+                reach = std::max(reach, variant.getAttackTable(type).getReach(color, sq).count());
+            }
+            total += pieces * reach;
+        }
+        most = std::max(most, total);
+    }
+    return most;
+}
+
+#define INSTANTIATE(BB)                                                                                               \
+    template BB getAttackers(const BasicVariant<BB> &, const BasicPosition<BB> &, Square, Color);                     \
+    template bool isInCheck(const BasicVariant<BB> &, const BasicPosition<BB> &, Color);                              \
+    template void generatePseudoLegalMoves(const BasicVariant<BB> &, const BasicPosition<BB> &, MoveList &);          \
+    template void generateLegalMoves(const BasicVariant<BB> &, const BasicPosition<BB> &, MoveList &);                \
+    template int countLegalMoves(const BasicVariant<BB> &, const BasicPosition<BB> &);                                \
+    template void generateLegalCaptures(const BasicVariant<BB> &, const BasicPosition<BB> &, MoveList &);             \
+    template int maxPseudoLegalMoves(const BasicVariant<BB> &, const BasicPosition<BB> &);                            \
+    template bool isLegal(const BasicVariant<BB> &, const BasicPosition<BB> &, Move);
+RULES_FOR_EACH_BITBOARD(INSTANTIATE)
+#undef INSTANTIATE
+} // namespace rules
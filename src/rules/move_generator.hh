@@ -0,0 +1,110 @@
+/**
+ * @file move_generator.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains functions for generating moves and detecting attacks on the crown
+ * @date 2026-10-17
+ */
+
+#ifndef RULES_MOVE_GENERATOR_HH
+#define RULES_MOVE_GENERATOR_HH
+
+#include <rules/bitboard.hh>
+#include <rules/move.hh>
+#include <rules/position.hh>
+#include <rules/variant.hh>
+
+namespace rules
+{
+/*
+ * Each function is a template on the bitboard type, defined in move_generator.cc and instantiated there for every
+ * bitboard size.
+ */
+
+/**
+ * @brief Find the pieces of one side that attack a square. This is a reverse lookup: each piece type's table is read
+ * once at `sq` rather than once per attacking piece.
+ *
+ * @param variant the rules being played
+ * @param position the position
+ * @param sq the attacked square
+ * @param attacker the side whose pieces are attacking
+ * @return BB the squares of the attacking pieces
+ */
+template <typename BB>
+BB getAttackers(const BasicVariant<BB> &variant, const BasicPosition<BB> &position, Square sq, Color attacker);
+
+/**
+ * @brief Check whether a side's crowned piece is attacked. A side without a crown is never in check.
+ *
+ * @param variant the rules being played
+ * @param position the position
+ * @param color the side
+ * @return true the side's crown is attacked
+ * @return false the side's crown is safe, or the side has no crown
+ */
+template <typename BB> bool isInCheck(const BasicVariant<BB> &variant, const BasicPosition<BB> &position, Color color);
+
+/**
+ * @brief Generate every move the side to move's pieces can make, including ones that leave its crown attacked.
+ *
+ * @param variant the rules being played
+ * @param position the position
+ * @param moves the list to append the moves to
+ */
+template <typename BB>
+void generatePseudoLegalMoves(const BasicVariant<BB> &variant, const BasicPosition<BB> &position, MoveList &moves);
+
+/**
+ * @brief Generate every legal move for the side to move, i.e. every move that does not leave its crown attacked.
+ *
+ * @param variant the rules being played
+ * @param position the position
+ * @param moves the list to append the moves to
+ */
+template <typename BB>
+void generateLegalMoves(const BasicVariant<BB> &variant, const BasicPosition<BB> &position, MoveList &moves);
+
+/**
+ * @brief Count the legal moves for the side to move without generating them. The moves of several pieces of a type
+ * are counted together, so this is much cheaper than generating them when only the count is needed.
+ *
+ * @param variant the rules being played
+ * @param position the position
+ * @return int the number of legal moves
+ */
+template <typename BB> int countLegalMoves(const BasicVariant<BB> &variant, const BasicPosition<BB> &position);
+
+/**
+ * @brief Generate every legal move for the side to move that captures a piece.
+ *
+ * @param variant the rules being played
+ * @param position the position
+ * @param moves the list to append the moves to
+ */
+template <typename BB>
+void generateLegalCaptures(const BasicVariant<BB> &variant, const BasicPosition<BB> &position, MoveList &moves);
+
+/**
+ * @brief Bound the number of pseudo-legal moves a side can have in any position reachable from this one. Pieces are
+ * never added to the board, so each piece type contributes its count on each side times the most squares one piece of
+ * the type can reach from any square.
+ *
+ * @param variant the rules being played
+ * @param position the position
+ * @return int the most moves either side could generate at once
+ */
+template <typename BB> int maxPseudoLegalMoves(const BasicVariant<BB> &variant, const BasicPosition<BB> &position);
+
+/**
+ * @brief Check whether a pseudo-legal move leaves the mover's crown safe, without playing the move.
+ *
+ * @param variant the rules being played
+ * @param position the position
+ * @param move a move returned by generatePseudoLegalMoves() for this position
+ * @return true the move is legal
+ * @return false the move would leave the mover's crown attacked
+ */
+template <typename BB> bool isLegal(const BasicVariant<BB> &variant, const BasicPosition<BB> &position, Move move);
+} // namespace rules
+
+#endif // RULES_MOVE_GENERATOR_HH
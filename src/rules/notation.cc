@@ -0,0 +1,27 @@
+#include "notation.hh"
+#include <util/util.hh>
+
+namespace rules
+{
+template <typename BB> std::string squareName(const BasicBoardGeometry<BB> &geometry, Square sq)
+{
+    // columns past z are named like spreadsheet columns: aa, ab, ..., az, ba, ...
+    std::string column;
+    for (int x = geometry.xOf(sq) + 1; x > 0; x = (x - 1) / 26)
+    {
+        column.insert(column.begin(), static_cast<char>('a' + (x - 1) % 26));
+    }
+    return util::concat(column, geometry.getHeight() - geometry.yOf(sq));
+}
+
+template <typename BB> std::string moveName(const BasicBoardGeometry<BB> &geometry, Move move)
+{
+    return squareName(geometry, move.getFrom()) + squareName(geometry, move.getTo());
+}
+
+#define INSTANTIATE(BB)                                                                                               \
+    template std::string squareName(const BasicBoardGeometry<BB> &, Square);                                          \
+    template std::string moveName(const BasicBoardGeometry<BB> &, Move);
+RULES_FOR_EACH_BITBOARD(INSTANTIATE)
+#undef INSTANTIATE
+} // namespace rules
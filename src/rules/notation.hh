@@ -0,0 +1,37 @@
+/**
+ * @file notation.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains functions for writing squares and moves as text
+ * @date 2026-10-17
+ */
+
+#ifndef RULES_NOTATION_HH
+#define RULES_NOTATION_HH
+
+#include <rules/board_geometry.hh>
+#include <rules/move.hh>
+#include <string>
+
+namespace rules
+{
+/**
+ * @brief Get the name of a square in algebraic notation: a column letter from `a` on the left, followed by a row
+ * number from 1 at the bottom (white's side). Columns after `z` are named with two letters, `aa` to `zz`.
+ *
+ * @param geometry the board
+ * @param sq the square
+ * @return std::string the name, e.g. "c4"
+ */
+template <typename BB> std::string squareName(const BasicBoardGeometry<BB> &geometry, Square sq);
+
+/**
+ * @brief Get the name of a move as its from and to squares, e.g. "b1c3".
+ *
+ * @param geometry the board
+ * @param move the move
+ * @return std::string the name
+ */
+template <typename BB> std::string moveName(const BasicBoardGeometry<BB> &geometry, Move move);
+} // namespace rules
+
+#endif // RULES_NOTATION_HH
@@ -0,0 +1,97 @@
+#include "occupancy_table.hh"
+#include <optional>
+#include <random>
+
+namespace rules
+{
+#if !defined(__BMI2__)
+/**
+ * @brief The seed of the random numbers tried as magic numbers, fixed so that tables compile the same way every run.
+ *
+ */
+static constexpr std::uint64_t MAGIC_SEED = 0x9e3779b97f4a7c15;
+/**
+ * @brief How many magic numbers to try for a table size before giving the table another bit. A table exactly as
+ * large as the number of arrangements of pieces needs a perfect magic number, which can take millions of tries to
+ * find for the larger masks; one twice as large almost always has one among the first few hundred.
+ *
+ */
+static constexpr int MAGIC_ATTEMPTS = 4096;
+
+/**
+ * @brief Try to find a magic number that maps every arrangement of pieces on a mask to an index of a table, such that
+ * arrangements sharing an index have the same result. Sparse random numbers are tried; the table is left filled in
+ * for the one that works.
+ *
+ * @param shift how far the product of the pieces and the magic number is shifted to get the index
+ * @param occupancies every arrangement of pieces
+ * @param results the result for each arrangement
+ * @param table the table, with an entry for every index
+ * @param random the source of candidate magic numbers
+ * @return std::optional<std::uint64_t> the magic number, or std::nullopt if none of MAGIC_ATTEMPTS tries worked
+ */
+static std::optional<std::uint64_t> findMagic(unsigned shift, const std::vector<std::uint64_t> &occupancies,
+                                              const std::vector<Bitboard> &results, std::vector<Bitboard> &table,
+                                              std::mt19937_64 &random)
+{
+    // the attempt that last wrote each entry, so that the table need not be cleared between attempts
+    std::vector<int> writtenBy(table.size(), 0);
+    for (int attempt = 1; attempt <= MAGIC_ATTEMPTS; attempt++)
+    {
+        std::uint64_t magic = random() & random() & random();
+        std::size_t i = 0;
+        for (; i < occupancies.size(); i++)
+        {
+            std::size_t index = (occupancies[i] * magic) >> shift;
+            if (writtenBy[index] != attempt)
+            {
+                writtenBy[index] = attempt;
+                table[index] = results[i];
+            }
+            else if (table[index] != results[i])
+            {
+                break;
+            }
+        }
+        if (i == occupancies.size())
+        {
+            return magic;
+        }
+    }
+    return std::nullopt;
+}
+#endif
+
+void OccupancyTable::insert(std::uint64_t mask, const std::vector<std::uint64_t> &occupancies,
+                            const std::vector<Bitboard> &entryResults)
+{
+    Entry entry;
+    entry.mask = mask;
+    entry.magic = 0;
+    entry.shift = 0;
+    entry.offset = static_cast<std::uint32_t>(results.size());
+#if defined(__BMI2__)
+    results.resize(results.size() + occupancies.size());
+    for (std::size_t i = 0; i < occupancies.size(); i++)
+    {
+        results[entry.offset + entry.indexOf(occupancies[i])] = entryResults[i];
+    }
+#else
+    std::mt19937_64 random(MAGIC_SEED);
+    for (int tableBits = Bitboard(mask).count();; tableBits++)
+    {
+        // with no squares in the mask, every index is 0 whatever the magic number
+        entry.shift = tableBits == 0 ? 63 : 64 - tableBits;
+        std::vector<Bitboard> table(std::size_t(1) << tableBits);
+        std::optional<std::uint64_t> magic = findMagic(entry.shift, occupancies, entryResults, table, random);
+        if (magic)
+        {
+            entry.magic = *magic;
+            results.insert(results.end(), table.begin(), table.end());
+            break;
+        }
+    }
+#endif
+    entries.push_back(entry);
+}
+} // namespace rules
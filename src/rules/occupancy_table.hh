@@ -0,0 +1,153 @@
+/**
+ * @file occupancy_table.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains the OccupancyTable class
+ * @date 2026-10-17
+ */
+
+#ifndef RULES_OCCUPANCY_TABLE_HH
+#define RULES_OCCUPANCY_TABLE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <rules/bitboard.hh>
+#include <vector>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace rules
+{
+/**
+ * @brief A set of lookup tables, for a board of up to 64 squares, of squares that depend on which of a few other
+ * squares are occupied, such as the squares a rider attacks given the pieces on its rays.
+ *
+ * Each entry is a mask of the squares whose occupancy matters, and a table with a result for every arrangement of
+ * pieces on them. The pieces are turned into an index into the table with PEXT when the compiler targets BMI2, and
+ * with a multiplication by a magic number found when the entry is added otherwise.
+ *
+ */
+class OccupancyTable
+{
+  public:
+    /**
+     * @brief The most squares an entry's mask may have. Each square doubles the size of the entry's table.
+     *
+     */
+    static constexpr int MAX_INDEX_BITS = 12;
+
+    /**
+     * @brief Add an entry, computing its result for every arrangement of pieces on its mask. Entries are numbered
+     * from 0 in the order they are added.
+     *
+     * @tparam Compute the type of the function that computes the results
+     * @param mask the squares whose occupancy matters, no more than MAX_INDEX_BITS of them
+     * @param compute called with each arrangement of pieces on the mask, returning the result for it
+     */
+    template <typename Compute> void add(Bitboard mask, Compute &&compute)
+    {
+        std::vector<std::uint64_t> occupancies;
+        std::vector<Bitboard> entryResults;
+        // enumerate every subset of the mask
+        std::uint64_t subset = 0;
+        do
+        {
+            occupancies.push_back(subset);
+            entryResults.push_back(compute(Bitboard(subset)));
+            subset = (subset - mask.getWord(0)) & mask.getWord(0);
+        } while (subset != 0);
+        insert(mask.getWord(0), occupancies, entryResults);
+    }
+
+    /**
+     * @brief Check whether no entries have been added.
+     *
+     * @return true there are no entries
+     * @return false there is at least one entry
+     */
+    bool empty() const noexcept
+    {
+        return entries.empty();
+    }
+    /**
+     * @brief Look up an entry's result.
+     *
+     * @param entry the entry's number
+     * @param occupied the occupied squares
+     * @return Bitboard the result for the pieces on the entry's mask
+     */
+    Bitboard get(std::size_t entry, Bitboard occupied) const
+    {
+        const Entry &e = entries[entry];
+        return results[e.offset + e.indexOf(occupied.getWord(0))];
+    }
+
+  private:
+    /**
+     * @brief Where to find one entry's results.
+     *
+     */
+    struct Entry
+    {
+        /**
+         * @brief The squares whose occupancy matters.
+         *
+         */
+        std::uint64_t mask;
+        /**
+         * @brief The magic number that maps the pieces on the mask to an index when PEXT is not available.
+         *
+         */
+        std::uint64_t magic;
+        /**
+         * @brief How far the product of the pieces and the magic number is shifted to get the index.
+         *
+         */
+        unsigned shift;
+        /**
+         * @brief The index of the entry's first result in `results`.
+         *
+         */
+        std::uint32_t offset;
+
+        /**
+         * @brief Get the index of an arrangement of pieces in the entry's part of the table.
+         *
+         * @param occupied the occupied squares
+         * @return std::size_t the index
+         */
+        std::size_t indexOf(std::uint64_t occupied) const
+        {
+#if defined(__BMI2__)
+            return _pext_u64(occupied, mask);
+#else
+            return ((occupied & mask) * magic) >> shift;
+#endif
+        }
+    };
+
+    /**
+     * @brief Add an entry's table, finding a magic number for it if PEXT is not available.
+     *
+     * @param mask the squares whose occupancy matters
+     * @param occupancies every arrangement of pieces on the mask
+     * @param entryResults the result for each arrangement
+     */
+    void insert(std::uint64_t mask, const std::vector<std::uint64_t> &occupancies,
+                const std::vector<Bitboard> &entryResults);
+
+    /**
+     * @brief The entries, in the order they were added.
+     *
+     */
+    std::vector<Entry> entries;
+    /**
+     * @brief The results of every entry for every arrangement of pieces.
+     *
+     */
+    std::vector<Bitboard> results;
+};
+} // namespace rules
+
+#endif // RULES_OCCUPANCY_TABLE_HH
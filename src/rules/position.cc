@@ -0,0 +1,206 @@
+#include "position.hh"
+#include <stdexcept>
+
+namespace rules
+{
+template <typename BB>
+BasicPosition<BB>::BasicPosition() : byColor(), byType(), crowns{NO_SQUARE, NO_SQUARE}, sideToMove(Color::White), key(0)
+{
+    board.fill(NO_PIECE);
+}
+
+template <typename BB> void BasicPosition<BB>::place(Color color, PieceType type, Square sq)
+{
+    if (type < 0 || type >= MAX_PIECE_TYPES)
+    {
+        throw std::out_of_range("placing piece: piece type out of range");
+    }
+    if (getOccupied().test(sq))
+    {
+        throw std::runtime_error("placing piece: square is already occupied");
+    }
+    byColor[indexOf(color)].set(sq);
+    byType[type].set(sq);
+    board[sq] = makePiece(color, type);
+    key ^= zobrist::pieceKey(color, type, sq);
+}
+
+template <typename BB> void BasicPosition<BB>::remove(Square sq)
+{
+    PieceType type = getTypeAt(sq);
+    if (type == NO_PIECE_TYPE)
+    {
+        throw std::runtime_error("removing piece: square is empty");
+    }
+    Color color = getColorAt(sq);
+    if (crowns[indexOf(color)] == sq)
+    {
+        crowns[indexOf(color)] = NO_SQUARE;
+        key ^= zobrist::crownKey(color, sq);
+    }
+    byColor[indexOf(color)].reset(sq);
+    byType[type].reset(sq);
+    board[sq] = NO_PIECE;
+    key ^= zobrist::pieceKey(color, type, sq);
+}
+
+template <typename BB> void BasicPosition<BB>::makeMove(Move move)
+{
+    UndoInfo undo;
+    makeMove(move, undo);
+}
+
+template <typename BB> void BasicPosition<BB>::makeMove(Move move, UndoInfo &undo)
+{
+    Square from = move.getFrom();
+    Square to = move.getTo();
+    Color us = sideToMove;
+    Color them = opposite(sideToMove);
+    zobrist::Key oldKey = key;
+
+    undo.captured = static_cast<std::int8_t>(NO_PIECE_TYPE);
+    undo.capturedCrown = false;
+    if (board[to] != NO_PIECE)
+    {
+        PieceType captured = typeOf(board[to]);
+        undo.captured = static_cast<std::int8_t>(captured);
+        byType[captured].reset(to);
+        byColor[indexOf(them)].reset(to);
+        key ^= zobrist::pieceKey(them, captured, to);
+        if (crowns[indexOf(them)] == to)
+        {
+            undo.capturedCrown = true;
+            crowns[indexOf(them)] = NO_SQUARE;
+            key ^= zobrist::crownKey(them, to);
+        }
+    }
+
+    PieceType type = typeOf(board[from]);
+    undo.moved = static_cast<std::int8_t>(type);
+    board[to] = board[from];
+    board[from] = NO_PIECE;
+    BB fromTo = BB::fromSquare(from) | BB::fromSquare(to);
+    byType[type] ^= fromTo;
+    byColor[indexOf(us)] ^= fromTo;
+    key ^= zobrist::pieceKey(us, type, from) ^ zobrist::pieceKey(us, type, to);
+    if (crowns[indexOf(us)] == from)
+    {
+        crowns[indexOf(us)] = to;
+        key ^= zobrist::crownKey(us, from) ^ zobrist::crownKey(us, to);
+    }
+    sideToMove = them;
+    key ^= zobrist::blackToMoveKey();
+    undo.keyDelta = oldKey ^ key;
+}
+
+template <typename BB> void BasicPosition<BB>::unmakeMove(Move move, const UndoInfo &undo)
+{
+    Square from = move.getFrom();
+    Square to = move.getTo();
+    Color them = sideToMove;
+    Color us = opposite(sideToMove);
+
+    BB fromTo = BB::fromSquare(from) | BB::fromSquare(to);
+    byType[undo.moved] ^= fromTo;
+    byColor[indexOf(us)] ^= fromTo;
+    board[from] = board[to];
+    board[to] = NO_PIECE;
+    if (crowns[indexOf(us)] == to)
+    {
+        crowns[indexOf(us)] = from;
+    }
+
+    if (undo.captured != NO_PIECE_TYPE)
+    {
+        byType[undo.captured].set(to);
+        byColor[indexOf(them)].set(to);
+        board[to] = makePiece(them, undo.captured);
+        if (undo.capturedCrown)
+        {
+            crowns[indexOf(them)] = to;
+        }
+    }
+    sideToMove = us;
+    key ^= undo.keyDelta;
+}
+
+template <typename BB> BB BasicPosition<BB>::getOccupied() const noexcept
+{
+    return byColor[indexOf(Color::White)] | byColor[indexOf(Color::Black)];
+}
+
+template <typename BB> BB BasicPosition<BB>::getPieces(Color color) const noexcept
+{
+    return byColor[indexOf(color)];
+}
+
+template <typename BB> BB BasicPosition<BB>::getPieces(PieceType type) const noexcept
+{
+    return byType[type];
+}
+
+template <typename BB> BB BasicPosition<BB>::getPieces(Color color, PieceType type) const noexcept
+{
+    return byColor[indexOf(color)] & byType[type];
+}
+
+template <typename BB> PieceCode BasicPosition<BB>::getPieceAt(Square sq) const noexcept
+{
+    return board[sq];
+}
+
+template <typename BB> PieceType BasicPosition<BB>::getTypeAt(Square sq) const noexcept
+{
+    return board[sq] == NO_PIECE ? NO_PIECE_TYPE : typeOf(board[sq]);
+}
+
+template <typename BB> Color BasicPosition<BB>::getColorAt(Square sq) const noexcept
+{
+    return colorOf(board[sq]);
+}
+
+template <typename BB> Square BasicPosition<BB>::getCrown(Color color) const noexcept
+{
+    return crowns[indexOf(color)];
+}
+
+template <typename BB> void BasicPosition<BB>::setCrown(Color color, Square sq)
+{
+    if (sq != NO_SQUARE && !byColor[indexOf(color)].test(sq))
+    {
+        throw std::runtime_error("giving crown to a square without a piece of that color");
+    }
+    if (crowns[indexOf(color)] != NO_SQUARE)
+    {
+        key ^= zobrist::crownKey(color, crowns[indexOf(color)]);
+    }
+    crowns[indexOf(color)] = sq;
+    if (sq != NO_SQUARE)
+    {
+        key ^= zobrist::crownKey(color, sq);
+    }
+}
+
+template <typename BB> Color BasicPosition<BB>::getSideToMove() const noexcept
+{
+    return sideToMove;
+}
+
+template <typename BB> void BasicPosition<BB>::setSideToMove(Color color) noexcept
+{
+    if (color != sideToMove)
+    {
+        key ^= zobrist::blackToMoveKey();
+    }
+    sideToMove = color;
+}
+
+template <typename BB> zobrist::Key BasicPosition<BB>::getKey() const noexcept
+{
+    return key;
+}
+
+#define INSTANTIATE(BB) template class BasicPosition<BB>;
+RULES_FOR_EACH_BITBOARD(INSTANTIATE)
+#undef INSTANTIATE
+} // namespace rules
@@ -0,0 +1,231 @@
+/**
+ * @file position.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains the BasicPosition class template
+ * @date 2026-10-17
+ */
+
+#ifndef RULES_POSITION_HH
+#define RULES_POSITION_HH
+
+#include <array>
+#include <cstdint>
+#include <rules/bitboard.hh>
+#include <rules/move.hh>
+#include <rules/types.hh>
+#include <rules/zobrist.hh>
+
+namespace rules
+{
+/**
+ * @brief What BasicPosition::makeMove() destroys, so that BasicPosition::unmakeMove() can restore it. It is a few
+ * bytes and fixed in size, so a search can keep one per ply on a stack instead of copying positions.
+ *
+ */
+struct UndoInfo
+{
+    /**
+     * @brief The Zobrist key before the move XORed with the key after it.
+     *
+     */
+    zobrist::Key keyDelta;
+    /**
+     * @brief The type of the piece that moved.
+     *
+     */
+    std::int8_t moved;
+    /**
+     * @brief The type of the piece captured by the move, or NO_PIECE_TYPE if it captured nothing.
+     *
+     */
+    std::int8_t captured;
+    /**
+     * @brief Whether the captured piece wore its side's crown.
+     *
+     */
+    bool capturedCrown;
+};
+
+/**
+ * @brief The placement of every piece on the board, plus the state that goes with it (crowns and the side to move).
+ *
+ * A position is a flat value made of bitboards, plus one byte per square naming the piece on it so that looking up a
+ * square doesn't scan the bitboards. It can be copied cheaply and stays in cache. It does not know the shape of the
+ * board; see BasicBoardGeometry for that.
+ *
+ * @tparam BB the bitboard type of the board
+ */
+template <typename BB> class BasicPosition
+{
+  public:
+    /**
+     * @brief Construct an empty position with white to move.
+     *
+     */
+    BasicPosition();
+
+    /**
+     * @brief Put a piece on an empty square.
+     *
+     * @param color the piece's color
+     * @param type the piece's type, less than MAX_PIECE_TYPES
+     * @param sq the square, which must be empty
+     */
+    void place(Color color, PieceType type, Square sq);
+    /**
+     * @brief Take the piece off a square. If the piece wore its side's crown, the crown is taken with it.
+     *
+     * @param sq the square, which must be occupied
+     */
+    void remove(Square sq);
+
+    /**
+     * @brief Play a move for the side to move: capture whatever is on the target square, move the piece (and its
+     * crown, if it wears one), and pass the turn. The move is not checked for legality.
+     *
+     * @param move a move of one of the side to move's pieces to a square not occupied by its own pieces
+     */
+    void makeMove(Move move);
+    /**
+     * @brief Play a move as makeMove(Move) does, recording what it destroys so that it can be taken back.
+     *
+     * @param move a move of one of the side to move's pieces to a square not occupied by its own pieces
+     * @param undo where to record what unmakeMove() needs
+     */
+    void makeMove(Move move, UndoInfo &undo);
+    /**
+     * @brief Take back the last move played, restoring the position exactly as it was before it.
+     *
+     * @param move the move, which must be the last one played
+     * @param undo what makeMove() recorded when playing it
+     */
+    void unmakeMove(Move move, const UndoInfo &undo);
+
+    /**
+     * @brief Get every occupied square.
+     *
+     * @return BB the occupied squares
+     */
+    BB getOccupied() const noexcept;
+    /**
+     * @brief Get the squares occupied by one side.
+     *
+     * @param color the side
+     * @return BB the squares
+     */
+    BB getPieces(Color color) const noexcept;
+    /**
+     * @brief Get the squares occupied by one type of piece, of either color.
+     *
+     * @param type the piece type
+     * @return BB the squares
+     */
+    BB getPieces(PieceType type) const noexcept;
+    /**
+     * @brief Get the squares occupied by one type of piece of one color.
+     *
+     * @param color the side
+     * @param type the piece type
+     * @return BB the squares
+     */
+    BB getPieces(Color color, PieceType type) const noexcept;
+
+    /**
+     * @brief Get the piece on a square.
+     *
+     * @param sq the square
+     * @return PieceCode the piece, or NO_PIECE if the square is empty
+     */
+    PieceCode getPieceAt(Square sq) const noexcept;
+    /**
+     * @brief Get the type of the piece on a square.
+     *
+     * @param sq the square
+     * @return PieceType the type, or NO_PIECE_TYPE if the square is empty
+     */
+    PieceType getTypeAt(Square sq) const noexcept;
+    /**
+     * @brief Get the color of the piece on a square. The square must be occupied.
+     *
+     * @param sq the square
+     * @return Color the color
+     */
+    Color getColorAt(Square sq) const noexcept;
+
+    /**
+     * @brief Get the square of the piece wearing a side's crown.
+     *
+     * @param color the side
+     * @return Square the square, or NO_SQUARE if the side has no crowned piece
+     */
+    Square getCrown(Color color) const noexcept;
+    /**
+     * @brief Give a side's crown to the piece on a square. Only one piece per side can wear a crown.
+     *
+     * @param color the side
+     * @param sq the square of a piece of that side, or NO_SQUARE to take the crown away
+     */
+    void setCrown(Color color, Square sq);
+
+    /**
+     * @brief Get the side whose turn it is.
+     *
+     * @return Color the side to move
+     */
+    Color getSideToMove() const noexcept;
+    /**
+     * @brief Set the side whose turn it is.
+     *
+     * @param color the side to move
+     */
+    void setSideToMove(Color color) noexcept;
+
+    /**
+     * @brief Get the position's Zobrist key, which identifies the placement of the pieces, the crowns and the side to
+     * move. It is kept up to date as the position changes rather than recomputed.
+     *
+     * @return zobrist::Key the key
+     */
+    zobrist::Key getKey() const noexcept;
+
+  private:
+    /**
+     * @brief The squares occupied by each color.
+     *
+     */
+    std::array<BB, COLOR_COUNT> byColor;
+    /**
+     * @brief The squares occupied by each piece type, regardless of color.
+     *
+     */
+    std::array<BB, MAX_PIECE_TYPES> byType;
+    /**
+     * @brief The piece on each square, or NO_PIECE.
+     *
+     */
+    std::array<PieceCode, BB::CAPACITY> board;
+    /**
+     * @brief The square of each side's crowned piece, or NO_SQUARE.
+     *
+     */
+    std::array<Square, COLOR_COUNT> crowns;
+    /**
+     * @brief The side whose turn it is.
+     *
+     */
+    Color sideToMove;
+    /**
+     * @brief The Zobrist key of everything above.
+     *
+     */
+    zobrist::Key key;
+};
+
+/**
+ * @brief A position on a board of up to 64 squares.
+ *
+ */
+using Position = BasicPosition<Bitboard>;
+} // namespace rules
+
+#endif // RULES_POSITION_HH
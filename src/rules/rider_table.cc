@@ -0,0 +1,180 @@
+#include "rider_table.hh"
+#include <algorithm>
+
+namespace rules
+{
+template <typename BB>
+BasicRiderTable<BB>::BasicRiderTable(const BasicBoardGeometry<BB> &geometry, const std::vector<Offset> &offsets)
+    : squareCount(geometry.getSquareCount()), directionCount(0), groupCount(0)
+{
+    std::vector<Offset> directions;
+    for (const Offset &offset : offsets)
+    {
+        if (offset.range == 1 || !offset.capture || (offset.dx == 0 && offset.dy == 0))
+        {
+            continue;
+        }
+        auto same = std::find_if(directions.begin(), directions.end(), [&](const Offset &direction) {
+            return direction.dx == offset.dx && direction.dy == offset.dy && direction.hop == offset.hop;
+        });
+        if (same == directions.end())
+        {
+            directions.push_back(offset);
+        }
+        else
+        {
+            same->range = std::max(same->range, offset.range);
+        }
+    }
+    directionCount = static_cast<int>(directions.size());
+
+    rays.resize(COLOR_COUNT * squareCount * directionCount);
+    increasing.resize(COLOR_COUNT * directionCount);
+    for (const Offset &direction : directions)
+    {
+        hops.push_back(direction.hop);
+    }
+    if (std::find(hops.begin(), hops.end(), true) != hops.end())
+    {
+        hopperRays.resize(COLOR_COUNT * squareCount);
+    }
+    for (Color color : {Color::White, Color::Black})
+    {
+        // white moves forward up the board, black moves forward down it
+        int sign = color == Color::White ? 1 : -1;
+        for (int direction = 0; direction < directionCount; direction++)
+        {
+            int stepX = sign * directions[direction].dx;
+            int stepY = -sign * directions[direction].dy;
+            increasing[indexOf(color) * directionCount + direction] = stepY * geometry.getWidth() + stepX > 0;
+            for (Square from : geometry.getOnBoard())
+            {
+                BB &ray = rays[(indexOf(color) * squareCount + from) * directionCount + direction];
+                int x = geometry.xOf(from);
+                int y = geometry.yOf(from);
+                // a disabled square ends the ray like the edge of the board
+                for (int step = 0; step < directions[direction].range; step++)
+                {
+                    x += stepX;
+                    y += stepY;
+                    if (!geometry.contains(x, y) || !geometry.isEnabled(geometry.squareAt(x, y)))
+                    {
+                        break;
+                    }
+                    ray.set(geometry.squareAt(x, y));
+                }
+                if (hops[direction])
+                {
+                    hopperRays[indexOf(color) * squareCount + from] |= ray;
+                }
+            }
+        }
+    }
+
+    if constexpr (std::is_same_v<BB, Bitboard>)
+    {
+        buildGroups();
+    }
+    else
+    {
+        for (int direction = 0; direction < directionCount; direction++)
+        {
+            scannedDirections.push_back(direction);
+        }
+    }
+}
+
+template <typename BB> void BasicRiderTable<BB>::buildGroups()
+{
+    // a blocker on the last square of a ray never changes the attacks, so only the squares before it matter
+    std::vector<BB> relevant(rays.size());
+    for (Color color : {Color::White, Color::Black})
+    {
+        for (Square sq = 0; sq < squareCount; sq++)
+        {
+            for (int direction = 0; direction < directionCount; direction++)
+            {
+                BB ray = getRay(color, sq, direction);
+                if (!ray.empty())
+                {
+                    bool up = increasing[indexOf(color) * directionCount + direction];
+                    relevant[(indexOf(color) * squareCount + sq) * directionCount + direction] =
+                        ray.without(BB::fromSquare(up ? ray.highest() : ray.lowest()));
+                }
+            }
+        }
+    }
+
+    // pack each direction into the first group it fits in, counting the relevant squares from every square
+    std::vector<std::vector<int>> packed;
+    std::vector<std::vector<int>> packedBits;
+    for (int direction = 0; direction < directionCount; direction++)
+    {
+        std::vector<int> bits(COLOR_COUNT * squareCount);
+        for (std::size_t i = 0; i < bits.size(); i++)
+        {
+            bits[i] = relevant[i * directionCount + direction].count();
+        }
+        if (*std::max_element(bits.begin(), bits.end()) > OccupancyTable::MAX_INDEX_BITS)
+        {
+            scannedDirections.push_back(direction);
+            continue;
+        }
+        std::size_t group = 0;
+        for (; group < packed.size(); group++)
+        {
+            bool fits = true;
+            for (std::size_t i = 0; i < bits.size() && fits; i++)
+            {
+                fits = packedBits[group][i] + bits[i] <= OccupancyTable::MAX_INDEX_BITS;
+            }
+            if (fits)
+            {
+                break;
+            }
+        }
+        if (group == packed.size())
+        {
+            packed.emplace_back();
+            packedBits.emplace_back(bits.size(), 0);
+        }
+        packed[group].push_back(direction);
+        for (std::size_t i = 0; i < bits.size(); i++)
+        {
+            packedBits[group][i] += bits[i];
+        }
+    }
+    groupCount = static_cast<int>(packed.size());
+
+    for (Color color : {Color::White, Color::Black})
+    {
+        for (Square sq = 0; sq < squareCount; sq++)
+        {
+            for (int g = 0; g < groupCount; g++)
+            {
+                BB mask;
+                for (int direction : packed[g])
+                {
+                    mask |= relevant[(indexOf(color) * squareCount + sq) * directionCount + direction];
+                }
+                // this is only ever called for Bitboard, but is compiled for every bitboard type
+                if constexpr (std::is_same_v<BB, Bitboard>)
+                {
+                    groups.add(mask, [&](BB occupied) {
+                        BB attacks;
+                        for (int direction : packed[g])
+                        {
+                            attacks |= scan(color, sq, direction, occupied);
+                        }
+                        return attacks;
+                    });
+                }
+            }
+        }
+    }
+}
+
+#define INSTANTIATE(BB) template class BasicRiderTable<BB>;
+RULES_FOR_EACH_BITBOARD(INSTANTIATE)
+#undef INSTANTIATE
+} // namespace rules
@@ -0,0 +1,215 @@
+/**
+ * @file rider_table.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains the BasicRiderTable class template
+ * @date 2026-10-17
+ */
+
+#ifndef RULES_RIDER_TABLE_HH
+#define RULES_RIDER_TABLE_HH
+
+#include <cstdint>
+#include <rules/bitboard.hh>
+#include <rules/board_geometry.hh>
+#include <rules/occupancy_table.hh>
+#include <rules/types.hh>
+#include <type_traits>
+#include <vector>
+
+namespace rules
+{
+/**
+ * @brief A piece type's rider and hopper moves, compiled for one board into tables of the squares it attacks given
+ * the pieces in its way.
+ *
+ * Each direction is a ray of squares from each square, in the piece's own frame as for BasicAttackTable. On a board
+ * of up to 64 squares, the directions are packed into groups whose rays cross few enough squares that every
+ * arrangement of blockers on them can be looked up in an OccupancyTable. Directions whose rays are too long for a
+ * table, and every direction on larger boards, are scanned instead: the nearest blocker on the ray is found with one
+ * bit scan, and the ray beyond it is removed with one lookup. A hopper's direction is scanned twice, once for its
+ * screen and once for the first piece beyond it.
+ *
+ * The members used while searching are defined here so that they can be inlined into the move generator.
+ *
+ * @tparam BB the bitboard type of the board
+ */
+template <typename BB> class BasicRiderTable
+{
+  public:
+    /**
+     * @brief Compile a piece's rider and hopper moves for a board. Offsets with a range of 1 are leaper moves, and
+     * are left out, as are offsets that cannot capture.
+     *
+     * @param geometry the board
+     * @param offsets the piece's moves, relative to its square
+     */
+    BasicRiderTable(const BasicBoardGeometry<BB> &geometry, const std::vector<Offset> &offsets);
+
+    /**
+     * @brief Check whether the piece has no rider moves.
+     *
+     * @return true the piece has no rider moves
+     * @return false the piece has at least one rider move
+     */
+    bool empty() const noexcept
+    {
+        return directionCount == 0;
+    }
+    /**
+     * @brief Check whether any of the piece's rider moves are hopper moves.
+     *
+     * @return true the piece has hopper moves
+     * @return false the piece has no hopper moves
+     */
+    bool hasHoppers() const noexcept
+    {
+        return !hopperRays.empty();
+    }
+
+    /**
+     * @brief Get the squares a rider attacks: every square along each of its rays up to and including the first
+     * occupied one, or for a hopper, every square after the first occupied one up to and including the next.
+     *
+     * @param color the piece's color
+     * @param sq the piece's square
+     * @param occupied the occupied squares
+     * @return BB the squares it attacks
+     */
+    BB getAttacks(Color color, Square sq, BB occupied) const
+    {
+        BB attacks;
+        if constexpr (std::is_same_v<BB, Bitboard>)
+        {
+            std::size_t group = (indexOf(color) * squareCount + sq) * groupCount;
+            for (int g = 0; g < groupCount; g++)
+            {
+                attacks |= groups.get(group + g, occupied);
+            }
+        }
+        for (int direction : scannedDirections)
+        {
+            attacks |= scan(color, sq, direction, occupied);
+        }
+        return attacks;
+    }
+    /**
+     * @brief Get the squares of every hopper ray from a square on an empty board: those where a piece could be a
+     * hopper's screen.
+     *
+     * @param color the piece's color
+     * @param sq the piece's square
+     * @return BB the squares of the rays, or no squares if the piece has no hopper moves
+     */
+    BB getHopperRays(Color color, Square sq) const
+    {
+        return hopperRays.empty() ? BB() : hopperRays[indexOf(color) * squareCount + sq];
+    }
+
+  private:
+    /**
+     * @brief Get the squares a rider attacks in one direction, by scanning for the nearest blocker.
+     *
+     * @param color the piece's color
+     * @param sq the piece's square
+     * @param direction the direction
+     * @param occupied the occupied squares
+     * @return BB the squares it attacks in that direction
+     */
+    BB scan(Color color, Square sq, int direction, BB occupied) const
+    {
+        BB ray = getRay(color, sq, direction);
+        BB blockers = ray & occupied;
+        bool up = increasing[indexOf(color) * directionCount + direction];
+        if (hops[direction])
+        {
+            if (blockers.empty())
+            {
+                return BB();
+            }
+            // go on from the screen, no further than the ray from the hopper itself
+            ray &= getRay(color, up ? blockers.lowest() : blockers.highest(), direction);
+            blockers = ray & occupied;
+        }
+        if (!blockers.empty())
+        {
+            ray = ray.without(getRay(color, up ? blockers.lowest() : blockers.highest(), direction));
+        }
+        return ray;
+    }
+    /**
+     * @brief Get the squares of a ray on an empty board.
+     *
+     * @param color the piece's color
+     * @param sq the piece's square
+     * @param direction the direction
+     * @return BB the ray
+     */
+    BB getRay(Color color, Square sq, int direction) const
+    {
+        return rays[(indexOf(color) * squareCount + sq) * directionCount + direction];
+    }
+    /**
+     * @brief Pack the directions into groups small enough to index, and fill in their tables. Only used on boards of
+     * up to 64 squares.
+     *
+     */
+    void buildGroups();
+
+    /**
+     * @brief The number of squares per color in `rays` and `groups`.
+     *
+     */
+    int squareCount;
+    /**
+     * @brief The number of directions the piece rides in.
+     *
+     */
+    int directionCount;
+    /**
+     * @brief The squares of each ray on an empty board, indexed by color, then square, then direction.
+     *
+     */
+    std::vector<BB> rays;
+    /**
+     * @brief Whether each direction goes up the square numbering, indexed by color and then direction. The nearest
+     * blocker on such a ray is its lowest square.
+     *
+     */
+    std::vector<std::uint8_t> increasing;
+    /**
+     * @brief Whether each direction is a hopper's.
+     *
+     */
+    std::vector<std::uint8_t> hops;
+    /**
+     * @brief The union of the hopper rays from each square, indexed by color and then square, or empty if the piece
+     * has no hopper moves.
+     *
+     */
+    std::vector<BB> hopperRays;
+    /**
+     * @brief The directions that are scanned rather than looked up.
+     *
+     */
+    std::vector<int> scannedDirections;
+    /**
+     * @brief The number of groups of directions that are looked up.
+     *
+     */
+    int groupCount;
+    /**
+     * @brief The attacks of every group for every arrangement of blockers, numbered by color, then square, then
+     * group.
+     *
+     */
+    OccupancyTable groups;
+};
+
+/**
+ * @brief A piece type's rider moves, compiled for a board of up to 64 squares.
+ *
+ */
+using RiderTable = BasicRiderTable<Bitboard>;
+} // namespace rules
+
+#endif // RULES_RIDER_TABLE_HH
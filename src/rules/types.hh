@@ -0,0 +1,196 @@
+/**
+ * @file types.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains the small value types shared by the rules of the game.
+ * @date 2026-10-17
+ */
+
+#ifndef RULES_TYPES_HH
+#define RULES_TYPES_HH
+
+#include <climits>
+#include <cstdint>
+
+/**
+ * @namespace rules
+ * @brief Contains the rules of the game: board representation, move tables and move generation.
+ * Nothing in this namespace depends on SDL, so it can be used by headless tools as well as the game.
+ *
+ */
+namespace rules
+{
+/**
+ * @brief The side a piece belongs to.
+ *
+ */
+enum class Color : std::uint8_t
+{
+    White,
+    Black
+};
+
+/**
+ * @brief The number of colors, for sizing arrays indexed by Color.
+ *
+ */
+constexpr int COLOR_COUNT = 2;
+
+/**
+ * @brief Get the other side.
+ *
+ * @param color the color
+ * @return Color the opposing color
+ */
+constexpr Color opposite(Color color)
+{
+    return color == Color::White ? Color::Black : Color::White;
+}
+
+/**
+ * @brief Get the array index of a color.
+ *
+ * @param color the color
+ * @return int 0 for white, 1 for black
+ */
+constexpr int indexOf(Color color)
+{
+    return static_cast<int>(color);
+}
+
+/**
+ * @brief The index of a square on the board, counted left to right and then top to bottom.
+ *
+ */
+using Square = int;
+
+/**
+ * @brief A sentinel value meaning "no square", e.g. for a side that has no crown.
+ *
+ */
+constexpr Square NO_SQUARE = -1;
+
+/**
+ * @brief The dense ID of a piece type within a variant.
+ *
+ */
+using PieceType = int;
+
+/**
+ * @brief A sentinel value meaning "no piece type", e.g. for an empty square.
+ *
+ */
+constexpr PieceType NO_PIECE_TYPE = -1;
+
+/**
+ * @brief The largest number of distinct piece types a variant can have.
+ *
+ */
+constexpr int MAX_PIECE_TYPES = 16;
+
+/**
+ * @brief A piece of one type and color, packed into one byte: the type in the upper bits and the color in the lowest
+ * bit. This is all the rules need to know about a piece; how it looks is up to whoever draws it.
+ *
+ */
+using PieceCode = std::uint8_t;
+
+/**
+ * @brief A sentinel value meaning "no piece", e.g. for an empty square.
+ *
+ */
+constexpr PieceCode NO_PIECE = 0xff;
+
+/**
+ * @brief Pack a piece's type and color into a code.
+ *
+ * @param color the piece's color
+ * @param type the piece's type, less than MAX_PIECE_TYPES
+ * @return PieceCode the code
+ */
+constexpr PieceCode makePiece(Color color, PieceType type)
+{
+    return static_cast<PieceCode>(type << 1 | indexOf(color));
+}
+
+/**
+ * @brief Get the type of a piece.
+ *
+ * @param piece the piece's code, which must not be NO_PIECE
+ * @return PieceType the type
+ */
+constexpr PieceType typeOf(PieceCode piece)
+{
+    return piece >> 1;
+}
+
+/**
+ * @brief Get the color of a piece.
+ *
+ * @param piece the piece's code, which must not be NO_PIECE
+ * @return Color the color
+ */
+constexpr Color colorOf(PieceCode piece)
+{
+    return static_cast<Color>(piece & 1);
+}
+
+/**
+ * @brief A move relative to a piece's current square, in the piece's own frame of reference. Positive dy is forward
+ * and negative dx is to the piece's left, so the same offset means opposite board directions for white and black.
+ *
+ * An offset with a range greater than 1 is a rider's move: the piece may repeat it up to `range` times in a straight
+ * line, stopping at the first piece in its way, which it may capture. A hopper's move is a rider's move that must
+ * first jump over exactly one piece, its screen, and then goes on like a rider; a lame leaper's move is a leaper's
+ * move that a piece on the square one step toward its target blocks. Either kind of move may also be limited to only
+ * moving to empty squares or only capturing.
+ *
+ */
+struct Offset
+{
+    /**
+     * @brief The range of a rider that may repeat its offset until it reaches the edge of the board.
+     *
+     */
+    static constexpr int UNLIMITED = INT_MAX;
+
+    /**
+     * @brief The sideways component. Negative values are to the left.
+     *
+     */
+    int dx;
+    /**
+     * @brief The forward component. Positive values are forward.
+     *
+     */
+    int dy;
+    /**
+     * @brief The number of times the offset may be repeated in a line: 1 for a leaper's move.
+     *
+     */
+    int range = 1;
+    /**
+     * @brief Whether the move must jump over exactly one piece before it may move or capture, like a cannon's.
+     *
+     */
+    bool hop = false;
+    /**
+     * @brief Whether a piece on the square one step toward the target blocks the move, like a xiangqi horse's. The
+     * step goes one square along whichever axis the move goes furthest along, or diagonally if it goes as far along
+     * both, so the move must go at least two squares along some axis.
+     *
+     */
+    bool lame = false;
+    /**
+     * @brief Whether the move may go to an empty square.
+     *
+     */
+    bool quiet = true;
+    /**
+     * @brief Whether the move may capture.
+     *
+     */
+    bool capture = true;
+};
+} // namespace rules
+
+#endif // RULES_TYPES_HH
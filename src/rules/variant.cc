@@ -0,0 +1,50 @@
+#include "variant.hh"
+#include <stdexcept>
+
+namespace rules
+{
+template <typename BB>
+BasicVariant<BB>::BasicVariant(BasicBoardGeometry<BB> geometry) : geometry(geometry), blockableAttacks(false)
+{
+}
+
+template <typename BB> PieceType BasicVariant<BB>::addPieceType(const std::vector<Offset> &offsets)
+{
+    return addPieceType(BasicAttackTable<BB>(geometry, offsets));
+}
+
+template <typename BB> PieceType BasicVariant<BB>::addPieceType(BasicAttackTable<BB> attackTable)
+{
+    if (attackTables.size() == MAX_PIECE_TYPES)
+    {
+        throw std::length_error("adding piece type: variant already has the maximum number of piece types");
+    }
+    blockableAttacks = blockableAttacks || attackTable.hasBlockableAttacks();
+    attackTables.push_back(std::move(attackTable));
+    return static_cast<PieceType>(attackTables.size() - 1);
+}
+
+template <typename BB> const BasicBoardGeometry<BB> &BasicVariant<BB>::getGeometry() const noexcept
+{
+    return geometry;
+}
+
+template <typename BB> int BasicVariant<BB>::getPieceTypeCount() const noexcept
+{
+    return static_cast<int>(attackTables.size());
+}
+
+template <typename BB> const BasicAttackTable<BB> &BasicVariant<BB>::getAttackTable(PieceType type) const noexcept
+{
+    return attackTables[type];
+}
+
+template <typename BB> bool BasicVariant<BB>::hasBlockableAttacks() const noexcept
+{
+    return blockableAttacks;
+}
+
+#define INSTANTIATE(BB) template class BasicVariant<BB>;
+RULES_FOR_EACH_BITBOARD(INSTANTIATE)
+#undef INSTANTIATE
+} // namespace rules
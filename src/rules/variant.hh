@@ -0,0 +1,105 @@
+/**
+ * @file variant.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains the BasicVariant class template
+ * @date 2026-10-17
+ */
+
+#ifndef RULES_VARIANT_HH
+#define RULES_VARIANT_HH
+
+#include <rules/attack_table.hh>
+#include <rules/board_geometry.hh>
+#include <rules/types.hh>
+#include <vector>
+
+namespace rules
+{
+/**
+ * @brief The fixed rules of a game: the board, and the piece types that can appear on it. A piece type's ID is its
+ * index in the order the types were added.
+ *
+ * @tparam BB the bitboard type of the board
+ */
+template <typename BB> class BasicVariant
+{
+  public:
+    /**
+     * @brief Construct a variant with no piece types yet.
+     *
+     * @param geometry the board
+     */
+    explicit BasicVariant(BasicBoardGeometry<BB> geometry);
+
+    /**
+     * @brief Add a piece type, compiling its moves for this variant's board.
+     *
+     * @param offsets the piece's moves, relative to its square
+     * @return PieceType the new type's ID
+     * @throw std::length_error if the variant already has MAX_PIECE_TYPES types
+     */
+    PieceType addPieceType(const std::vector<Offset> &offsets);
+    /**
+     * @brief Add a piece type whose moves were already compiled for this variant's board.
+     *
+     * @param attackTable the piece's compiled moves
+     * @return PieceType the new type's ID
+     * @throw std::length_error if the variant already has MAX_PIECE_TYPES types
+     */
+    PieceType addPieceType(BasicAttackTable<BB> attackTable);
+
+    /**
+     * @brief Get the board.
+     *
+     * @return const BasicBoardGeometry<BB>& the board
+     */
+    const BasicBoardGeometry<BB> &getGeometry() const noexcept;
+    /**
+     * @brief Get the number of piece types.
+     *
+     * @return int the number of types
+     */
+    int getPieceTypeCount() const noexcept;
+    /**
+     * @brief Get the compiled moves of a piece type.
+     *
+     * @param type the piece type
+     * @return const BasicAttackTable<BB>& the attack table
+     */
+    const BasicAttackTable<BB> &getAttackTable(PieceType type) const noexcept;
+    /**
+     * @brief Check whether any piece type's attacks can be blocked or enabled by other pieces, as a rider's, a
+     * hopper's or a lame leaper's can. Otherwise no piece can be pinned, so the move generator can skip looking for
+     * pins.
+     *
+     * @return true some piece type's attacks depend on other pieces
+     * @return false every piece type only attacks by leaping
+     */
+    bool hasBlockableAttacks() const noexcept;
+
+  private:
+    /**
+     * @brief The board.
+     *
+     */
+    BasicBoardGeometry<BB> geometry;
+    /**
+     * @brief The compiled moves of each piece type, indexed by PieceType.
+     *
+     */
+    std::vector<BasicAttackTable<BB>> attackTables;
+    /**
+     * @brief Whether any piece type's attacks can be blocked or enabled by other pieces.
+     *
+     */
+    bool blockableAttacks;
+};
+
+/**
+ * @brief The rules of a game on a board of up to 64 squares.
+ *
+ */
+using Variant = BasicVariant<Bitboard>;
+} // namespace rules
+
+#endif // RULES_VARIANT_HH
@@ -0,0 +1,51 @@
+#include "zobrist.hh"
+
+namespace rules::zobrist
+{
+/**
+ * @brief Advance a SplitMix64 generator and return its next output.
+ *
+ * @param state the generator's state
+ * @return Key a pseudo-random 64-bit value
+ */
+static constexpr Key nextKey(std::uint64_t &state)
+{
+    state += 0x9e3779b97f4a7c15ULL;
+    std::uint64_t z = state;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Generate every key from a fixed seed.
+ *
+ * @return Keys the keys
+ */
+static constexpr Keys generateKeys()
+{
+    Keys keys{};
+    std::uint64_t state = 0x43686573735661ULL;
+    for (auto &type : keys.pieces)
+    {
+        for (auto &color : type)
+        {
+            for (Key &key : color)
+            {
+                key = nextKey(state);
+            }
+        }
+    }
+    for (auto &color : keys.crowns)
+    {
+        for (Key &key : color)
+        {
+            key = nextKey(state);
+        }
+    }
+    keys.blackToMove = nextKey(state);
+    return keys;
+}
+
+constexpr Keys KEYS = generateKeys();
+} // namespace rules::zobrist
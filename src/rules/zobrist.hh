@@ -0,0 +1,94 @@
+/**
+ * @file zobrist.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains the random keys used to hash positions
+ * @date 2026-10-17
+ */
+
+#ifndef RULES_ZOBRIST_HH
+#define RULES_ZOBRIST_HH
+
+#include <cstdint>
+#include <rules/bitboard.hh>
+#include <rules/types.hh>
+
+/**
+ * @namespace rules::zobrist
+ * @brief Contains the keys for Zobrist hashing. A position's key is the XOR of the keys of everything in it, so
+ * making a move only needs to XOR in the keys of what changed.
+ *
+ */
+namespace rules::zobrist
+{
+/**
+ * @brief A 64-bit position hash.
+ *
+ */
+using Key = std::uint64_t;
+
+/**
+ * @brief Every key, generated once from a fixed seed so that keys are the same from run to run.
+ *
+ */
+struct Keys
+{
+    /**
+     * @brief The key of each piece type, of each color, on each square.
+     *
+     */
+    Key pieces[MAX_PIECE_TYPES][COLOR_COUNT][MAX_SQUARES];
+    /**
+     * @brief The key of each side's crown being on each square.
+     *
+     */
+    Key crowns[COLOR_COUNT][MAX_SQUARES];
+    /**
+     * @brief The key of black being the side to move.
+     *
+     */
+    Key blackToMove;
+};
+
+/**
+ * @brief The keys. They are computed at compile time.
+ *
+ */
+extern const Keys KEYS;
+
+/**
+ * @brief Get the key of a piece on a square.
+ *
+ * @param color the piece's color
+ * @param type the piece's type
+ * @param sq the square
+ * @return Key the key
+ */
+inline Key pieceKey(Color color, PieceType type, Square sq)
+{
+    return KEYS.pieces[type][indexOf(color)][sq];
+}
+
+/**
+ * @brief Get the key of a side's crown being on a square.
+ *
+ * @param color the side
+ * @param sq the square
+ * @return Key the key
+ */
+inline Key crownKey(Color color, Square sq)
+{
+    return KEYS.crowns[indexOf(color)][sq];
+}
+
+/**
+ * @brief Get the key of black being the side to move. It is XORed in and out each time the turn passes.
+ *
+ * @return Key the key
+ */
+inline Key blackToMoveKey()
+{
+    return KEYS.blackToMove;
+}
+} // namespace rules::zobrist
+
+#endif // RULES_ZOBRIST_HH
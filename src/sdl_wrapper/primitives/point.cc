@@ -4,6 +4,16 @@ namespace sdl::primitives
 {
 bool Point::operator<(const SDL_Point &other) const
 {
-    return (x * x + y * y) < (other.x * other.x + other.y * other.y);
+    int magnitude = x * x + y * y;
+    int otherMagnitude = other.x * other.x + other.y * other.y;
+    if (magnitude != otherMagnitude)
+    {
+        return magnitude < otherMagnitude;
+    }
+    if (x != other.x)
+    {
+        return x < other.x;
+    }
+    return y < other.y;
 }
 } // namespace sdl::primitives
\ No newline at end of file
@@ -25,11 +25,12 @@ struct Point : public SDL_Point
 {
   public:
     /**
-     * @brief Compare two points.
+     * @brief Compare two points. Points are ordered by magnitude, and points of equal magnitude are ordered by x and
+     * then by y, so distinct points never compare equal.
      * 
      * @param other the other point
-     * @return true the magnitude of this point is less than the other's
-     * @return false the magnitude of this point is not less than the other's
+     * @return true this point comes before the other
+     * @return false this point does not come before the other
      */
     bool operator<(const SDL_Point &other) const;
   private:
@@ -0,0 +1,90 @@
+/**
+ * @file render_state_cache.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains the RenderStateCache and ElidedCalls structs
+ * @date 2026-10-17
+ */
+
+#ifndef SDL_WRAPPER_RENDER_RENDER_STATE_CACHE_HH
+#define SDL_WRAPPER_RENDER_RENDER_STATE_CACHE_HH
+
+#include <SDL2/SDL_render.h>
+#include <optional>
+
+namespace sdl::render
+{
+/**
+ * @brief The number of state changes a renderer skipped because they would not have changed anything, by kind.
+ *
+ */
+struct ElidedCalls
+{
+    /**
+     * @brief Skipped calls to WeakRenderer::setDrawColor.
+     *
+     */
+    long drawColor = 0;
+    /**
+     * @brief Skipped calls to WeakRenderer::setBlendMode.
+     *
+     */
+    long blendMode = 0;
+    /**
+     * @brief Skipped calls to WeakRenderer::setTarget and WeakRenderer::resetTarget.
+     *
+     */
+    long target = 0;
+    /**
+     * @brief Skipped calls to WeakRenderer::setClip.
+     *
+     */
+    long clip = 0;
+    /**
+     * @brief Skipped calls to WeakRenderer::setViewport.
+     *
+     */
+    long viewport = 0;
+};
+
+/**
+ * @brief The state a renderer was last set to through the wrapper, so that setting it to the same value again can be
+ * skipped. A member is empty while the state is unknown: before it is first set, after a call that failed, and after
+ * a call that changes it as a side effect.
+ *
+ */
+struct RenderStateCache
+{
+    /**
+     * @brief The draw color.
+     *
+     */
+    std::optional<SDL_Color> drawColor;
+    /**
+     * @brief The draw blend mode.
+     *
+     */
+    std::optional<SDL_BlendMode> blendMode;
+    /**
+     * @brief The render target, null for the default target.
+     *
+     */
+    std::optional<SDL_Texture *> target;
+    /**
+     * @brief The clip rectangle of the current target.
+     *
+     */
+    std::optional<SDL_Rect> clip;
+    /**
+     * @brief The viewport of the current target.
+     *
+     */
+    std::optional<SDL_Rect> viewport;
+    /**
+     * @brief The calls skipped so far.
+     *
+     */
+    ElidedCalls elided;
+};
+} // namespace sdl::render
+
+#endif // SDL_WRAPPER_RENDER_RENDER_STATE_CACHE_HH
@@ -30,9 +30,12 @@ Renderer::~Renderer()
     }
 }
 
-Renderer::Renderer(Renderer &&other) noexcept : WeakRenderer(other.handle)
+Renderer::Renderer(Renderer &&other) noexcept
+    : WeakRenderer(other.handle), ownedStateCache(std::move(other.ownedStateCache))
 {
+    stateCache = other.stateCache;
     other.handle = nullptr;
+    other.stateCache = nullptr;
 }
 
 Renderer &Renderer::operator=(Renderer &&other) noexcept
@@ -40,9 +43,18 @@ Renderer &Renderer::operator=(Renderer &&other) noexcept
     if (&other != this)
     {
         handle = other.handle;
+        stateCache = other.stateCache;
+        ownedStateCache = std::move(other.ownedStateCache);
         other.handle = nullptr;
+        other.stateCache = nullptr;
     }
     return *this;
 }
 
+void Renderer::setStateCaching(bool enabled)
+{
+    ownedStateCache = enabled ? std::make_unique<RenderStateCache>() : nullptr;
+    stateCache = ownedStateCache.get();
+}
+
 } // namespace sdl::render
\ No newline at end of file
@@ -9,6 +9,7 @@
 #define SDL_WRAPPER_RENDER_RENDERER_HH
 
 #include <SDL2/SDL_render.h>
+#include <memory>
 #include <optional>
 #include <sdl_wrapper/render/weak_renderer.hh>
 #include <vector>
@@ -69,6 +70,24 @@ class Renderer : public WeakRenderer
      * @return Renderer& the object that was moved to
      */
     Renderer &operator=(Renderer &&other) noexcept;
+
+    /**
+     * @brief Set whether to remember the renderer's state, so that setting the draw color, blend mode, target, clip or
+     * viewport to the value it already has skips the call to SDL. Turning caching on starts with the state unknown,
+     * and WeakRenderers copied from this renderer after that share the cache. The state must then only be changed
+     * through such copies, and WeakRenderer::invalidateStateCache must be called when SDL changes it. Copies made
+     * while caching was on must not be used after it is turned off or on again.
+     *
+     * @param enabled whether to cache the state
+     */
+    void setStateCaching(bool enabled);
+
+  private:
+    /**
+     * @brief The cached state, if caching is on. `stateCache` points to it.
+     *
+     */
+    std::unique_ptr<RenderStateCache> ownedStateCache;
 };
 } // namespace sdl::render
 
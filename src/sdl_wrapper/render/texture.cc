@@ -15,7 +15,7 @@ Texture::Texture(WeakRenderer renderer, Uint32 pixelFormat, int access, int w, i
     }
 }
 
-Texture::Texture(WeakRenderer renderer, surface::Surface &surface)
+Texture::Texture(WeakRenderer renderer, surface::WeakSurface surface)
     : WeakTexture(SDL_CreateTextureFromSurface(renderer.getHandle(), surface.getHandle()), surface.getHandle()->w,
                   surface.getHandle()->h)
 {
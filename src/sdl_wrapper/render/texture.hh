@@ -40,9 +40,9 @@ class Texture : public WeakTexture
      * @brief Construct a new Texture using an existing Surface.
      *
      * @param renderer a renderer, required to create textures
-     * @param surface the surface to consume in creating this texture
+     * @param surface the surface to copy the pixels of; it is not consumed, so it may be owned elsewhere
      */
-    Texture(WeakRenderer renderer, surface::Surface &surface);
+    Texture(WeakRenderer renderer, surface::WeakSurface surface);
 
     virtual ~Texture();
 
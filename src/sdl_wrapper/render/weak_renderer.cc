@@ -5,7 +5,20 @@
 
 namespace sdl::render
 {
-WeakRenderer::WeakRenderer(SDL_Renderer *handle) : handle(handle)
+/**
+ * @brief Compare two rectangles field by field.
+ *
+ * @param a a rectangle
+ * @param b another rectangle
+ * @return true the rectangles are the same
+ * @return false the rectangles differ
+ */
+static bool sameRect(SDL_Rect a, SDL_Rect b) noexcept
+{
+    return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+}
+
+WeakRenderer::WeakRenderer(SDL_Renderer *handle) : handle(handle), stateCache(nullptr)
 {
 }
 
@@ -13,6 +26,21 @@ SDL_Renderer *WeakRenderer::getHandle() const
 {
     return handle;
 }
+
+ElidedCalls WeakRenderer::getElidedCalls() const noexcept
+{
+    return stateCache != nullptr ? stateCache->elided : ElidedCalls();
+}
+
+void WeakRenderer::invalidateStateCache() noexcept
+{
+    if (stateCache != nullptr)
+    {
+        ElidedCalls elided = stateCache->elided;
+        *stateCache = RenderStateCache();
+        stateCache->elided = elided;
+    }
+}
 int WeakRenderer::getNumRenderDrivers()
 {
     return SDL_GetNumRenderDrivers();
@@ -100,11 +128,25 @@ void WeakRenderer::copy(const WeakTexture texture, std::optional<SDL_Rect> src,
 
 void WeakRenderer::setDrawColor(SDL_Color dc)
 {
+    if (stateCache != nullptr)
+    {
+        const std::optional<SDL_Color> &current = stateCache->drawColor;
+        if (current && current->r == dc.r && current->g == dc.g && current->b == dc.b && current->a == dc.a)
+        {
+            stateCache->elided.drawColor++;
+            return;
+        }
+        stateCache->drawColor.reset();
+    }
     int code = SDL_SetRenderDrawColor(handle, dc.r, dc.g, dc.b, dc.a);
     if (code != 0)
     {
         throw SDLException("setting renderer draw color");
     }
+    if (stateCache != nullptr)
+    {
+        stateCache->drawColor = dc;
+    }
 }
 
 void WeakRenderer::drawLine(SDL_Point p1, SDL_Point p2)
@@ -116,9 +158,9 @@ void WeakRenderer::drawLine(SDL_Point p1, SDL_Point p2)
     }
 }
 
-void WeakRenderer::drawLines(const std::vector<SDL_Point> &vertices)
+void WeakRenderer::drawLines(Span<const SDL_Point> vertices)
 {
-    int code = SDL_RenderDrawLines(handle, vertices.data(), vertices.size());
+    int code = SDL_RenderDrawLines(handle, vertices.data(), static_cast<int>(vertices.size()));
     if (code != 0)
     {
         throw SDLException("drawing lines to renderer");
@@ -134,9 +176,9 @@ void WeakRenderer::drawPoint(SDL_Point p)
     }
 }
 
-void WeakRenderer::drawPoints(const std::vector<SDL_Point> &points)
+void WeakRenderer::drawPoints(Span<const SDL_Point> points)
 {
-    int code = SDL_RenderDrawPoints(handle, points.data(), points.size());
+    int code = SDL_RenderDrawPoints(handle, points.data(), static_cast<int>(points.size()));
     if (code != 0)
     {
         throw SDLException("drawing points to renderer");
@@ -152,9 +194,9 @@ void WeakRenderer::drawRect(SDL_Rect r)
     }
 }
 
-void WeakRenderer::drawRects(const std::vector<SDL_Rect> &rects)
+void WeakRenderer::drawRects(Span<const SDL_Rect> rects)
 {
-    int code = SDL_RenderDrawRects(handle, rects.data(), rects.size());
+    int code = SDL_RenderDrawRects(handle, rects.data(), static_cast<int>(rects.size()));
     if (code != 0)
     {
         throw SDLException("drawing rects to renderer");
@@ -170,15 +212,34 @@ void WeakRenderer::fillRect(SDL_Rect r)
     }
 }
 
-void WeakRenderer::fillRects(const std::vector<SDL_Rect> &rects)
+void WeakRenderer::fillRects(Span<const SDL_Rect> rects)
 {
-    int code = SDL_RenderFillRects(handle, rects.data(), rects.size());
+    int code = SDL_RenderFillRects(handle, rects.data(), static_cast<int>(rects.size()));
     if (code != 0)
     {
         throw SDLException("filling rects to renderer");
     }
 }
 
+void WeakRenderer::drawGeometry(const WeakTexture texture, Span<const SDL_Vertex> vertices, Span<const int> indices)
+{
+    int code = SDL_RenderGeometry(handle, texture.getHandle(), vertices.data(), static_cast<int>(vertices.size()),
+                                  indices.data(), static_cast<int>(indices.size()));
+    if (code != 0)
+    {
+        throw SDLException("drawing geometry to renderer");
+    }
+}
+
+void WeakRenderer::flush()
+{
+    int code = SDL_RenderFlush(handle);
+    if (code != 0)
+    {
+        throw SDLException("flushing renderer");
+    }
+}
+
 void WeakRenderer::present() noexcept
 {
     SDL_RenderPresent(handle);
@@ -254,11 +315,24 @@ bool WeakRenderer::isClipEnabled() const noexcept
 
 void WeakRenderer::setClip(SDL_Rect clipRect)
 {
+    if (stateCache != nullptr)
+    {
+        if (stateCache->clip && sameRect(*stateCache->clip, clipRect))
+        {
+            stateCache->elided.clip++;
+            return;
+        }
+        stateCache->clip.reset();
+    }
     int code = SDL_RenderSetClipRect(handle, &clipRect);
     if (code != 0)
     {
         throw SDLException("setting renderer clip rect");
     }
+    if (stateCache != nullptr)
+    {
+        stateCache->clip = clipRect;
+    }
 }
 
 void WeakRenderer::setIntegerScale(bool forceIntegerScale)
@@ -272,6 +346,11 @@ void WeakRenderer::setIntegerScale(bool forceIntegerScale)
 
 void WeakRenderer::setLogicalSize(SDL_Rect size)
 {
+    // the logical size decides the viewport
+    if (stateCache != nullptr)
+    {
+        stateCache->viewport.reset();
+    }
     int code = SDL_RenderSetLogicalSize(handle, size.w, size.h);
     if (code != 0)
     {
@@ -281,6 +360,12 @@ void WeakRenderer::setLogicalSize(SDL_Rect size)
 
 void WeakRenderer::setScale(ScalingFactors scale)
 {
+    // the clip and viewport are in scaled coordinates
+    if (stateCache != nullptr)
+    {
+        stateCache->clip.reset();
+        stateCache->viewport.reset();
+    }
     int code = SDL_RenderSetScale(handle, scale.scaleX, scale.scaleY);
     if (code != 0)
     {
@@ -290,11 +375,24 @@ void WeakRenderer::setScale(ScalingFactors scale)
 
 void WeakRenderer::setViewport(SDL_Rect viewport)
 {
+    if (stateCache != nullptr)
+    {
+        if (stateCache->viewport && sameRect(*stateCache->viewport, viewport))
+        {
+            stateCache->elided.viewport++;
+            return;
+        }
+        stateCache->viewport.reset();
+    }
     int code = SDL_RenderSetViewport(handle, &viewport);
     if (code != 0)
     {
         throw SDLException("setting renderer viewport");
     }
+    if (stateCache != nullptr)
+    {
+        stateCache->viewport = viewport;
+    }
 }
 
 bool WeakRenderer::targetSupported() const noexcept
@@ -305,28 +403,75 @@ bool WeakRenderer::targetSupported() const noexcept
 
 void WeakRenderer::setBlendMode(SDL_BlendMode mode)
 {
+    if (stateCache != nullptr)
+    {
+        if (stateCache->blendMode == mode)
+        {
+            stateCache->elided.blendMode++;
+            return;
+        }
+        stateCache->blendMode.reset();
+    }
     int code = SDL_SetRenderDrawBlendMode(handle, mode);
     if (code != 0)
     {
         throw SDLException("setting renderer draw blend mode");
     }
+    if (stateCache != nullptr)
+    {
+        stateCache->blendMode = mode;
+    }
 }
 
 void WeakRenderer::setTarget(WeakTexture texture)
 {
+    if (!switchTarget(texture.getHandle()))
+    {
+        return;
+    }
     int code = SDL_SetRenderTarget(handle, texture.getHandle());
     if (code != 0)
     {
         throw SDLException("setting renderer target");
     }
+    if (stateCache != nullptr)
+    {
+        stateCache->target = texture.getHandle();
+    }
 }
 
 void WeakRenderer::resetTarget()
 {
+    if (!switchTarget(nullptr))
+    {
+        return;
+    }
     int code = SDL_SetRenderTarget(handle, nullptr);
     if (code != 0)
     {
         throw SDLException("resetting renderer target");
     }
+    if (stateCache != nullptr)
+    {
+        stateCache->target = nullptr;
+    }
+}
+
+bool WeakRenderer::switchTarget(SDL_Texture *target) noexcept
+{
+    if (stateCache == nullptr)
+    {
+        return true;
+    }
+    if (stateCache->target == target)
+    {
+        stateCache->elided.target++;
+        return false;
+    }
+    // each target has its own clip and viewport, which SDL swaps in along with the target
+    stateCache->target.reset();
+    stateCache->clip.reset();
+    stateCache->viewport.reset();
+    return true;
 }
 } // namespace sdl::render
\ No newline at end of file
@@ -10,8 +10,9 @@
 
 #include <SDL2/SDL_render.h>
 #include <optional>
+#include <sdl_wrapper/render/render_state_cache.hh>
 #include <sdl_wrapper/render/weak_texture.hh>
-#include <vector>
+#include <sdl_wrapper/span.hh>
 
 namespace sdl::render
 {
@@ -38,6 +39,10 @@ struct ScalingFactors
  * @brief A weak reference to a Renderer. Used as a return value for SDL functions that
  * return references to existing renderers.
  *
+ * If the renderer it refers to caches its state (see Renderer::setStateCaching), a reference copied from it shares the
+ * cache, and skips setting the draw color, blend mode, target, clip or viewport to the value it already has. A
+ * reference made from the bare handle does not know about the cache, so state it changes is not seen by the cache.
+ *
  */
 class WeakRenderer
 {
@@ -55,6 +60,20 @@ class WeakRenderer
      * @return SDL_Renderer*
      */
     SDL_Renderer *getHandle() const;
+    /**
+     * @brief Get the number of state changes skipped because the state already had the requested value.
+     *
+     * @return ElidedCalls the skipped calls, all zero if the renderer does not cache its state
+     */
+    ElidedCalls getElidedCalls() const noexcept;
+    /**
+     * @brief Forget the cached state, so that the next state changes all go to SDL. Call this after SDL changes the
+     * renderer's state behind the wrapper's back: after the window is resized, which resets the default target's
+     * viewport, after render targets or the device are reset, or after calling SDL with the handle directly. Does
+     * nothing if the renderer does not cache its state.
+     *
+     */
+    void invalidateStateCache() noexcept;
 
     /**
      * @brief Get the number of render drivers for this machine.
@@ -142,11 +161,11 @@ class WeakRenderer
     void drawLine(SDL_Point p1, SDL_Point p2);
     /**
      * @brief Connect the dots to form lines. Each point will have a line drawn between
-     * itself and the next point in the vector.
+     * itself and the next point in the array.
      *
      * @param vertices the points to connect
      */
-    void drawLines(const std::vector<SDL_Point> &vertices);
+    void drawLines(Span<const SDL_Point> vertices);
     /**
      * @brief Draw a point to the target. Typically this draws a single
      * pixel.
@@ -159,7 +178,7 @@ class WeakRenderer
      *
      * @param points the points to draw
      */
-    void drawPoints(const std::vector<SDL_Point> &points);
+    void drawPoints(Span<const SDL_Point> points);
     /**
      * @brief Draw the outline of the rectangle defined by `r` to the target.
      * If you want a filled rectangle, see Renderer::fillRect.
@@ -173,7 +192,7 @@ class WeakRenderer
      *
      * @param rects the rectangles to draw
      */
-    void drawRects(const std::vector<SDL_Rect> &rects);
+    void drawRects(Span<const SDL_Rect> rects);
     /**
      * @brief Draw the rectangle defined by `r` filled in with the draw color
      * to the target. If you want just the outline, see Renderer::drawRect.
@@ -187,7 +206,16 @@ class WeakRenderer
      *
      * @param rects the rectangles to draw
      */
-    void fillRects(const std::vector<SDL_Rect> &rects);
+    void fillRects(Span<const SDL_Rect> rects);
+    /**
+     * @brief Draw triangles, textured and colored per vertex, to the target in one call. Every three indices are a
+     * triangle.
+     *
+     * @param texture the texture the vertices' texture coordinates refer to
+     * @param vertices the vertices
+     * @param indices the indices of the vertices of each triangle, or empty to take the vertices in order
+     */
+    void drawGeometry(WeakTexture texture, Span<const SDL_Vertex> vertices, Span<const int> indices = {});
     /**
      * @brief Get the clip rectangle for the current render target. If clipping is disabled, returns an empty rectangle.
      *
@@ -290,6 +318,14 @@ class WeakRenderer
      * @param alpha the alpha mod
      */
     void setAlphaMod(Uint8 alpha);
+    /**
+     * @brief Execute the drawing commands SDL has queued up, without presenting. A software renderer drawing to its
+     * window's surface is then done with it, so parts of the surface can be pushed to the screen with
+     * video::WeakWindow::updateSurfaceAreas in place of present().
+     *
+     * @throw sdl::SDLException if there is an SDL error
+     */
+    void flush();
     /**
      * @brief Push the renderer's changes to the target
      *
@@ -297,11 +333,25 @@ class WeakRenderer
     void present() noexcept;
 
   protected:
+    /**
+     * @brief Prepare the state cache for a change of target, unless the target would not change.
+     *
+     * @param target the new target, or null for the default target
+     * @return true the target must be set
+     * @return false the target is already `target`; the call was counted as skipped
+     */
+    bool switchTarget(SDL_Texture *target) noexcept;
+
     /**
      * @brief The SDL handle for the renderer it uses. It is used internally.
      *
      */
     SDL_Renderer *handle;
+    /**
+     * @brief The renderer's cached state, owned by the Renderer, or null if it does not cache its state.
+     *
+     */
+    RenderStateCache *stateCache;
 };
 } // namespace sdl::render
 
@@ -35,6 +35,15 @@ SDL_BlendMode WeakTexture::getBlendMode() const
     return mode;
 }
 
+void WeakTexture::setBlendMode(SDL_BlendMode mode)
+{
+    int code = SDL_SetTextureBlendMode(handle, mode);
+    if (code != 0)
+    {
+        throw SDLException("setting texture blend mode");
+    }
+}
+
 SDL_Color WeakTexture::getColorMod() const
 {
     SDL_Color mod{0x00, 0x00, 0x00, 0xff};
@@ -62,6 +62,12 @@ class WeakTexture
      * @return SDL_BlendMode the blend mode
      */
     SDL_BlendMode getBlendMode() const;
+    /**
+     * @brief Set the texture's blend mode used in copy operations.
+     *
+     * @param mode the blend mode
+     */
+    void setBlendMode(SDL_BlendMode mode);
 
     /**
      * @brief Get the color multiplier used on copy operations for this texture.
@@ -0,0 +1,140 @@
+/**
+ * @file span.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains the Span class
+ * @date 2026-10-17
+ */
+
+#ifndef SDL_WRAPPER_SPAN_HH
+#define SDL_WRAPPER_SPAN_HH
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace sdl
+{
+/**
+ * @brief A non-owning view of a contiguous array, for functions that pass arrays straight through to SDL.
+ *
+ * Stands in for C++20's std::span. A span is made implicitly from a pointer and a count, a C array, or any container
+ * with contiguous data() and size() such as std::vector or std::array, so callers may keep their arrays wherever
+ * suits them, on the stack or in memory reused between frames, rather than building a vector for every call.
+ *
+ * @tparam T the element type, const-qualified for read-only views
+ */
+template <typename T> class Span
+{
+  public:
+    /**
+     * @brief Create an empty span.
+     *
+     */
+    constexpr Span() noexcept : first(nullptr), count(0)
+    {
+    }
+    /**
+     * @brief View `count` elements starting at `first`.
+     *
+     * @param first the first element, which may be null if `count` is 0
+     * @param count the number of elements
+     */
+    constexpr Span(T *first, std::size_t count) noexcept : first(first), count(count)
+    {
+    }
+    /**
+     * @brief View a C array.
+     *
+     * @tparam N the length of the array
+     * @param array the array
+     */
+    template <std::size_t N> constexpr Span(T (&array)[N]) noexcept : first(array), count(N)
+    {
+    }
+    /**
+     * @brief View the elements of a contiguous container.
+     *
+     * @tparam Container a type whose data() points to elements convertible to T and whose size() counts them
+     * @param container the container, which must outlive the span and not be reallocated while it is used
+     */
+    template <typename Container,
+              typename = std::enable_if_t<
+                  !std::is_same_v<std::remove_cv_t<Container>, Span> &&
+                  std::is_convertible_v<decltype(std::declval<Container &>().data()), T *> &&
+                  std::is_convertible_v<decltype(std::declval<Container &>().size()), std::size_t>>>
+    constexpr Span(Container &container) noexcept : first(container.data()), count(container.size())
+    {
+    }
+
+    /**
+     * @brief Get a pointer to the first element.
+     *
+     * @return T* the first element
+     */
+    constexpr T *data() const noexcept
+    {
+        return first;
+    }
+    /**
+     * @brief Get the number of elements.
+     *
+     * @return std::size_t the number of elements
+     */
+    constexpr std::size_t size() const noexcept
+    {
+        return count;
+    }
+    /**
+     * @brief Check whether the span has no elements.
+     *
+     * @return true the span is empty
+     * @return false the span has elements
+     */
+    constexpr bool empty() const noexcept
+    {
+        return count == 0;
+    }
+    /**
+     * @brief Get an iterator to the first element.
+     *
+     * @return T* the first element
+     */
+    constexpr T *begin() const noexcept
+    {
+        return first;
+    }
+    /**
+     * @brief Get an iterator past the last element.
+     *
+     * @return T* one past the last element
+     */
+    constexpr T *end() const noexcept
+    {
+        return first + count;
+    }
+    /**
+     * @brief Get an element.
+     *
+     * @param i the index of the element, less than size()
+     * @return T& the element
+     */
+    constexpr T &operator[](std::size_t i) const noexcept
+    {
+        return first[i];
+    }
+
+  private:
+    /**
+     * @brief The first element.
+     *
+     */
+    T *first;
+    /**
+     * @brief The number of elements.
+     *
+     */
+    std::size_t count;
+};
+} // namespace sdl
+
+#endif // SDL_WRAPPER_SPAN_HH
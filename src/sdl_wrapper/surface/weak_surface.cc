@@ -60,10 +60,10 @@ void WeakSurface::fillRect(SDL_Rect rect, SDL_Color color)
     }
 }
 
-void WeakSurface::fillRects(std::vector<SDL_Rect> rects, SDL_Color color)
+void WeakSurface::fillRects(Span<const SDL_Rect> rects, SDL_Color color)
 {
     Uint32 iColor = (color.r << 3) + (color.g << 2) + (color.b << 1) + (color.a);
-    int code = SDL_FillRects(handle, rects.data(), rects.size(), iColor);
+    int code = SDL_FillRects(handle, rects.data(), static_cast<int>(rects.size()), iColor);
     if (code != 0)
     {
         throw SDLException("filling surface rects");
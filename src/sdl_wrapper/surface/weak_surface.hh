@@ -10,7 +10,7 @@
 
 #include "SDL2/SDL_surface.h"
 #include <optional>
-#include <vector>
+#include <sdl_wrapper/span.hh>
 
 namespace sdl::surface
 {
@@ -67,7 +67,7 @@ class WeakSurface
      * @param rects the areas to fill
      * @param color the color to fill in
      */
-    void fillRects(std::vector<SDL_Rect> rects, SDL_Color color);
+    void fillRects(Span<const SDL_Rect> rects, SDL_Color color);
 
     /**
      * @brief Get the clip that is used for this surface.
@@ -11,6 +11,7 @@
 #include <SDL2/SDL_messagebox.h>
 #include <sdl_wrapper/video/message_box/message_box_button.hh>
 #include <sdl_wrapper/video/weak_window.hh>
+#include <vector>
 
 /**
  * @namespace sdl::video::message_box
@@ -280,9 +280,9 @@ void WeakWindow::updateSurface()
         throw SDLException("updating window surface");
     }
 }
-void WeakWindow::updateSurfaceAreas(std::vector<SDL_Rect> areas)
+void WeakWindow::updateSurfaceAreas(Span<const SDL_Rect> areas)
 {
-    int code = SDL_UpdateWindowSurfaceRects(handle, areas.data(), areas.size());
+    int code = SDL_UpdateWindowSurfaceRects(handle, areas.data(), static_cast<int>(areas.size()));
     if (code != 0)
     {
         throw SDLException("updating window surface areas");
@@ -12,6 +12,7 @@
 #include <SDL2/SDL_video.h>
 #include <array>
 #include <sdl_wrapper/render/renderer_builder.hh>
+#include <sdl_wrapper/span.hh>
 #include <sdl_wrapper/surface/weak_surface.hh>
 #include <string_view>
 
@@ -424,7 +425,7 @@ class WeakWindow
      *
      * @param areas an array of SDL_Rects specifying the areas to update
      */
-    void updateSurfaceAreas(std::vector<SDL_Rect> areas);
+    void updateSurfaceAreas(Span<const SDL_Rect> areas);
 
     /**
      * @brief Get the Renderer associated with this window.
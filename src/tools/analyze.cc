@@ -0,0 +1,141 @@
+/**
+ * @file analyze.cc
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief A headless tool that searches the starting position of a layout for the best move, and prints the search's
+ * progress after each iteration.
+ * @date 2026-10-17
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <engine/parallel_search.hh>
+#include <engine/transposition_table.hh>
+#include <io/layout_file.hh>
+#include <iostream>
+#include <rules/notation.hh>
+#include <string>
+#include <thread>
+#include <util/util.hh>
+
+/**
+ * @brief The size of the transposition table, in megabytes.
+ *
+ */
+constexpr std::size_t TABLE_MEGABYTES = 64;
+
+/**
+ * @brief Describe a score for printing.
+ *
+ * @param score the score
+ * @return std::string the score in centipawns, or the number of moves to mate
+ */
+static std::string scoreName(int score)
+{
+    if (engine::isMateScore(score))
+    {
+        int plies = engine::MATE_SCORE - std::abs(score);
+        int moves = (plies + 1) / 2;
+        return util::concat("mate ", score > 0 ? moves : -moves);
+    }
+    return util::concat("cp ", score);
+}
+
+/**
+ * @brief Describe a search result for printing, as one line.
+ *
+ * @tparam BB the bitboard type of the board
+ * @param variant the rules being played
+ * @param result the result
+ * @return std::string the description
+ */
+template <typename BB>
+static std::string resultLine(const rules::BasicVariant<BB> &variant, const engine::SearchResult &result)
+{
+    std::string line = util::concat("depth ", result.depth, " score ", scoreName(result.score), " nodes ",
+                                    result.nodes, " time ", result.time.count(), " pv");
+    for (rules::Move move : result.pv)
+    {
+        line += ' ';
+        line += rules::moveName(variant.getGeometry(), move);
+    }
+    return line;
+}
+
+/**
+ * @brief Search the starting position of a layout, printing each iteration and then the best move.
+ *
+ * @tparam BB the bitboard type of the layout's board
+ * @param layout the layout
+ * @param limits when to stop
+ * @param threads the number of threads to search with
+ */
+template <typename BB> static void analyze(const io::Layout &layout, const engine::SearchLimits &limits, int threads)
+{
+    rules::BasicVariant<BB> variant = io::createVariant<BB>(layout);
+    rules::BasicPosition<BB> position = io::createPosition<BB>(layout, variant);
+
+    engine::TranspositionTable table(TABLE_MEGABYTES);
+    engine::ParallelSearch search(variant, table, threads);
+    search.setIterationCallback(
+        [&variant](const engine::SearchResult &result) { std::cout << resultLine(variant, result) << '\n'; });
+    engine::SearchResult result = search.run(position, limits);
+
+    if (result.bestMove.isNull())
+    {
+        std::cout << "No legal moves (" << scoreName(result.score) << ")\n";
+        return;
+    }
+    std::cout << "Best move: " << rules::moveName(variant.getGeometry(), result.bestMove) << '\n';
+    std::cout << "Nodes: " << result.nodes << '\n';
+    std::cout << "Time: " << result.time.count() << " ms\n";
+    if (result.time.count() > 0)
+    {
+        std::cout << "Nodes/second: " << result.nodes * 1000 / result.time.count() << '\n';
+    }
+}
+
+/**
+ * @brief The main function.
+ *
+ * @param argc the number of arguments
+ * @param argv the arguments: a layout file, and optionally the depth to search, a time limit in milliseconds and the
+ * number of threads to search with
+ * @return int The exit status code.
+ * 0 for success, non-zero for failure.
+ */
+int main(int argc, char **argv)
+{
+    if (argc < 2 || argc > 5)
+    {
+        std::cerr << "usage: " << argv[0] << " <layout file> [depth] [time in ms] [threads]\n";
+        return 2;
+    }
+    try
+    {
+        io::Layout layout = io::readLayoutFile(argv[1]);
+        engine::SearchLimits limits;
+        if (argc >= 3)
+        {
+            limits.depth = util::parseInt<int>(argv[2]);
+        }
+        if (argc >= 4)
+        {
+            limits.time = std::chrono::milliseconds(util::parseInt(argv[3]));
+        }
+        int threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        if (argc >= 5)
+        {
+            threads = util::parseInt<int>(argv[4]);
+        }
+
+        rules::withBitboardFor(layout.width * layout.height,
+                               [&](auto bitboard) { analyze<decltype(bitboard)>(layout, limits, threads); });
+    }
+    catch (std::exception &e)
+    {
+        std::cerr << "analyze: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,128 @@
+/**
+ * @file bench.cc
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief A headless tool that searches the starting position of a layout to a fixed depth with increasing numbers of
+ * threads, and reports how the search scales.
+ * @date 2026-10-17
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <engine/parallel_search.hh>
+#include <engine/transposition_table.hh>
+#include <io/layout_file.hh>
+#include <iomanip>
+#include <iostream>
+#include <rules/notation.hh>
+#include <string_view>
+#include <thread>
+#include <util/util.hh>
+#include <vector>
+
+/**
+ * @brief The size of the transposition table, in megabytes.
+ *
+ */
+constexpr std::size_t TABLE_MEGABYTES = 256;
+
+/**
+ * @brief Choose the thread counts to benchmark: the powers of two below the maximum, and the maximum.
+ *
+ * @param maxThreads the most threads to use
+ * @return std::vector<int> the thread counts, in increasing order
+ */
+static std::vector<int> threadCounts(int maxThreads)
+{
+    std::vector<int> counts;
+    for (int threads = 1; threads < maxThreads; threads *= 2)
+    {
+        counts.push_back(threads);
+    }
+    counts.push_back(maxThreads);
+    return counts;
+}
+
+/**
+ * @brief Search the starting position of a layout with each thread count, printing a line of results per count.
+ *
+ * @tparam BB the bitboard type of the layout's board
+ * @param layout the layout
+ * @param limits when to stop each search
+ * @param maxThreads the most threads to use
+ * @param deterministic whether to search in deterministic mode
+ */
+template <typename BB>
+static void bench(const io::Layout &layout, const engine::SearchLimits &limits, int maxThreads, bool deterministic)
+{
+    rules::BasicVariant<BB> variant = io::createVariant<BB>(layout);
+    rules::BasicPosition<BB> position = io::createPosition<BB>(layout, variant);
+
+    engine::TranspositionTable table(TABLE_MEGABYTES);
+    double baseSeconds = 0;
+    std::cout << std::setw(7) << "threads" << std::setw(11) << "time (ms)" << std::setw(15) << "nodes"
+              << std::setw(13) << "nodes/s" << std::setw(13) << "nodes/s/thr" << std::setw(9) << "speedup"
+              << "  best move\n";
+    for (int threads : threadCounts(maxThreads))
+    {
+        // every run starts from an empty table, so no run benefits from an earlier one
+        table.clear(threads);
+        engine::ParallelSearch search(variant, table, threads, deterministic);
+        auto start = std::chrono::steady_clock::now();
+        engine::SearchResult result = search.run(position, limits);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        double seconds = std::max(elapsed.count(), 1e-9);
+        if (threads == 1)
+        {
+            baseSeconds = seconds;
+        }
+
+        auto nodesPerSecond = static_cast<std::uint64_t>(result.nodes / seconds);
+        std::string bestMove =
+            result.bestMove.isNull() ? "(none)" : rules::moveName(variant.getGeometry(), result.bestMove);
+        std::cout << std::setw(7) << threads << std::setw(11) << static_cast<std::uint64_t>(seconds * 1000)
+                  << std::setw(15) << result.nodes << std::setw(13) << nodesPerSecond << std::setw(13)
+                  << nodesPerSecond / threads << std::setw(8) << std::fixed << std::setprecision(2)
+                  << baseSeconds / seconds << "x  " << bestMove << std::endl;
+    }
+}
+
+/**
+ * @brief The main function.
+ *
+ * @param argc the number of arguments
+ * @param argv the arguments: a layout file, a depth, optionally the most threads to use (by default, one per core),
+ * and optionally `deterministic` for reproducible node counts
+ * @return int The exit status code.
+ * 0 for success, non-zero for failure.
+ */
+int main(int argc, char **argv)
+{
+    if (argc < 3 || argc > 5 || (argc == 5 && std::string_view(argv[4]) != "deterministic"))
+    {
+        std::cerr << "usage: " << argv[0] << " <layout file> <depth> [max threads] [deterministic]\n";
+        return 2;
+    }
+    try
+    {
+        io::Layout layout = io::readLayoutFile(argv[1]);
+        engine::SearchLimits limits;
+        limits.depth = util::parseInt<int>(argv[2]);
+        int maxThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        if (argc >= 4)
+        {
+            maxThreads = std::max(1, util::parseInt<int>(argv[3]));
+        }
+        bool deterministic = argc == 5;
+
+        rules::withBitboardFor(layout.width * layout.height, [&](auto bitboard) {
+            bench<decltype(bitboard)>(layout, limits, maxThreads, deterministic);
+        });
+    }
+    catch (std::exception &e)
+    {
+        std::cerr << "bench: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file perft.cc
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief A headless tool that counts the leaf nodes of the legal move tree of a layout, for checking the move
+ * generator against known counts and timing it.
+ * @date 2026-10-17
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <io/layout_file.hh>
+#include <iostream>
+#include <rules/move_generator.hh>
+#include <rules/notation.hh>
+#include <string_view>
+#include <util/util.hh>
+
+/**
+ * @brief Count the leaf nodes of the legal move tree.
+ *
+ * @tparam BB the bitboard type of the board
+ * @param variant the rules being played
+ * @param position the root of the tree; moves are made and unmade on it in place, so it is unchanged on return
+ * @param depth the number of plies to search
+ * @return std::uint64_t the number of positions reached after exactly `depth` plies
+ */
+template <typename BB>
+static std::uint64_t perft(const rules::BasicVariant<BB> &variant, rules::BasicPosition<BB> &position, int depth)
+{
+    if (depth == 0)
+    {
+        return 1;
+    }
+    if (depth == 1)
+    {
+        return rules::countLegalMoves(variant, position);
+    }
+    rules::MoveList moves;
+    rules::generateLegalMoves(variant, position, moves);
+    std::uint64_t nodes = 0;
+    rules::UndoInfo undo;
+    for (rules::Move move : moves)
+    {
+        position.makeMove(move, undo);
+        nodes += perft(variant, position, depth - 1);
+        position.unmakeMove(move, undo);
+    }
+    return nodes;
+}
+
+/**
+ * @brief Count the leaf nodes of a layout's legal move tree and print the count and how long it took.
+ *
+ * @tparam BB the bitboard type of the layout's board
+ * @param layout the layout
+ * @param depth the number of plies to search
+ * @param divide whether to also print the count below each root move
+ */
+template <typename BB> static void runPerft(const io::Layout &layout, int depth, bool divide)
+{
+    rules::BasicVariant<BB> variant = io::createVariant<BB>(layout);
+    rules::BasicPosition<BB> position = io::createPosition<BB>(layout, variant);
+
+    auto start = std::chrono::steady_clock::now();
+    std::uint64_t nodes = 0;
+    if (divide && depth > 0)
+    {
+        rules::MoveList moves;
+        rules::generateLegalMoves(variant, position, moves);
+        rules::UndoInfo undo;
+        for (rules::Move move : moves)
+        {
+            position.makeMove(move, undo);
+            std::uint64_t moveNodes = perft(variant, position, depth - 1);
+            position.unmakeMove(move, undo);
+            std::cout << rules::moveName(variant.getGeometry(), move) << ": " << moveNodes << '\n';
+            nodes += moveNodes;
+        }
+        std::cout << '\n';
+    }
+    else
+    {
+        nodes = perft(variant, position, depth);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "Nodes: " << nodes << '\n';
+    std::cout << "Time: " << static_cast<std::uint64_t>(elapsed.count() * 1000) << " ms\n";
+    if (elapsed.count() > 0)
+    {
+        std::cout << "Nodes/second: " << static_cast<std::uint64_t>(nodes / elapsed.count()) << '\n';
+    }
+}
+
+/**
+ * @brief The main function.
+ *
+ * @param argc the number of arguments
+ * @param argv the arguments: a layout file, a depth, and optionally `divide` to print the count below each root move
+ * @return int The exit status code.
+ * 0 for success, non-zero for failure.
+ */
+int main(int argc, char **argv)
+{
+    if (argc != 3 && !(argc == 4 && std::string_view(argv[3]) == "divide"))
+    {
+        std::cerr << "usage: " << argv[0] << " <layout file> <depth> [divide]\n";
+        return 2;
+    }
+    try
+    {
+        io::Layout layout = io::readLayoutFile(argv[1]);
+        int depth = util::parseInt<int>(argv[2]);
+        bool divide = argc == 4;
+        rules::withBitboardFor(layout.width * layout.height, [&](auto bitboard) {
+            runPerft<decltype(bitboard)>(layout, depth, divide);
+        });
+    }
+    catch (std::exception &e)
+    {
+        std::cerr << "perft: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file piecepack.cc
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief A tool that compiles a directory of piece files and their images into a piece pack, which the game maps at
+ * startup instead of parsing the piece files and decoding the images itself.
+ * @date 2026-10-17
+ */
+
+#include <SDL2/SDL_pixels.h>
+#include <algorithm>
+#include <filesystem>
+#include <io/piece_definition.hh>
+#include <io/piece_pack.hh>
+#include <iostream>
+#include <sdl_wrapper/image/context.hh>
+#include <sdl_wrapper/surface/surface.hh>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Decode an image into the pixel format of a piece pack.
+ *
+ * @param imageContext used to load images from file
+ * @param fileName the image file name
+ * @return io::PieceImage the decoded image
+ */
+static io::PieceImage decodeImage(sdl::image::Context &imageContext, const std::string &fileName)
+{
+    sdl::surface::Surface surface = imageContext.load(fileName).convertFormat(SDL_PIXELFORMAT_RGBA32);
+    SDL_Surface *handle = surface.getHandle();
+    io::PieceImage image{handle->w, handle->h, {}};
+    std::size_t rowBytes = static_cast<std::size_t>(handle->w) * io::PACKED_PIXEL_SIZE;
+    image.pixels.resize(rowBytes * static_cast<std::size_t>(handle->h));
+    surface.lock();
+    // rows of the surface may be padded; those of the pack are not
+    const auto *pixels = static_cast<const unsigned char *>(handle->pixels);
+    for (int y = 0; y < handle->h; y++)
+    {
+        const unsigned char *row = pixels + static_cast<std::ptrdiff_t>(y) * handle->pitch;
+        std::copy(row, row + rowBytes, image.pixels.begin() + static_cast<std::ptrdiff_t>(y * rowBytes));
+    }
+    surface.unlock();
+    return image;
+}
+
+/**
+ * @brief The main function.
+ *
+ * @param argc the number of arguments
+ * @param argv the arguments: the pack file to write, and the directory of piece files to compile. Image file names
+ * in a piece file are found relative to the piece file.
+ * @return int The exit status code.
+ * 0 for success, non-zero for failure.
+ */
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        std::cerr << "usage: " << argv[0] << " <pack file> <piece directory>\n";
+        return 2;
+    }
+    try
+    {
+        std::vector<std::filesystem::path> pieceFiles;
+        for (const std::filesystem::directory_entry &entry : std::filesystem::directory_iterator(argv[2]))
+        {
+            if (entry.is_regular_file() && entry.path().extension() == ".piece")
+            {
+                pieceFiles.push_back(entry.path());
+            }
+        }
+        std::sort(pieceFiles.begin(), pieceFiles.end());
+
+        sdl::image::Context imageContext(sdl::image::InitFlags::Png);
+        std::vector<io::PackedPiece> pieces;
+        for (const std::filesystem::path &pieceFile : pieceFiles)
+        {
+            io::PieceDefinition definition = io::parsePieceFile(pieceFile.string());
+            std::filesystem::path directory = pieceFile.parent_path();
+            io::PieceImage whiteImage = decodeImage(imageContext, (directory / definition.whiteFileName).string());
+            io::PieceImage blackImage = decodeImage(imageContext, (directory / definition.blackFileName).string());
+            pieces.push_back(io::PackedPiece{pieceFile.stem().string(), std::move(definition.name),
+                                             std::move(definition.moves), std::move(whiteImage),
+                                             std::move(blackImage)});
+        }
+        std::size_t pieceCount = pieces.size();
+        io::writePiecePack(argv[1], std::move(pieces));
+        std::cout << "Packed " << pieceCount << " pieces into " << argv[1] << '\n';
+    }
+    catch (std::exception &e)
+    {
+        std::cerr << "piecepack: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
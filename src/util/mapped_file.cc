@@ -0,0 +1,109 @@
+#include "mapped_file.hh"
+#include <stdexcept>
+#include <string>
+#include <util/util.hh>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace util
+{
+MappedFile::MappedFile(std::string_view fileName) : bytes(nullptr), length(0)
+{
+    std::string name(fileName);
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error(concat("mapping ", fileName, ": could not open file"));
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize))
+    {
+        CloseHandle(file);
+        throw std::runtime_error(concat("mapping ", fileName, ": could not get file size"));
+    }
+    length = static_cast<std::size_t>(fileSize.QuadPart);
+    if (length > 0)
+    {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping != nullptr)
+        {
+            bytes = static_cast<const unsigned char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            // the view keeps the mapping alive
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+#else
+    int fd = open(name.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error(concat("mapping ", fileName, ": could not open file"));
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0)
+    {
+        close(fd);
+        throw std::runtime_error(concat("mapping ", fileName, ": could not get file size"));
+    }
+    length = static_cast<std::size_t>(status.st_size);
+    if (length > 0)
+    {
+        void *address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        bytes = address == MAP_FAILED ? nullptr : static_cast<const unsigned char *>(address);
+    }
+    // the mapping keeps the file alive
+    close(fd);
+#endif
+    if (length > 0 && bytes == nullptr)
+    {
+        throw std::runtime_error(concat("mapping ", fileName, ": could not map file"));
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    unmap();
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept : bytes(other.bytes), length(other.length)
+{
+    other.bytes = nullptr;
+    other.length = 0;
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+    if (this != &other)
+    {
+        unmap();
+        bytes = other.bytes;
+        length = other.length;
+        other.bytes = nullptr;
+        other.length = 0;
+    }
+    return *this;
+}
+
+void MappedFile::unmap() noexcept
+{
+    if (bytes != nullptr)
+    {
+#if defined(_WIN32)
+        UnmapViewOfFile(bytes);
+#else
+        munmap(const_cast<unsigned char *>(bytes), length);
+#endif
+        bytes = nullptr;
+        length = 0;
+    }
+}
+} // namespace util
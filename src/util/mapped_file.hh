@@ -0,0 +1,89 @@
+/**
+ * @file mapped_file.hh
+ * @author Kyle Coffey (kylecoffey1999@gmail.com)
+ * @brief Contains the MappedFile class
+ * @date 2026-10-17
+ */
+
+#ifndef UTIL_MAPPED_FILE_HH
+#define UTIL_MAPPED_FILE_HH
+
+#include <cstddef>
+#include <string_view>
+
+namespace util
+{
+/**
+ * @brief A file mapped read-only into memory, so that its contents can be used in place without being read or
+ * copied. Pages are loaded by the operating system when they are first touched, and shared with other processes
+ * mapping the same file.
+ *
+ */
+class MappedFile
+{
+  public:
+    /**
+     * @brief Map a file into memory.
+     *
+     * @param fileName the file name
+     * @throw std::runtime_error if the file cannot be opened or mapped
+     */
+    explicit MappedFile(std::string_view fileName);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    /**
+     * @brief Take over another mapping. The other file is left empty.
+     *
+     * @param other the mapping to take over
+     */
+    MappedFile(MappedFile &&other) noexcept;
+    /**
+     * @brief Unmap this file and take over another mapping. The other file is left empty.
+     *
+     * @param other the mapping to take over
+     * @return MappedFile& this file
+     */
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    /**
+     * @brief Get the contents of the file.
+     *
+     * @return const unsigned char* the first byte, or nullptr if the file is empty
+     */
+    const unsigned char *data() const noexcept
+    {
+        return bytes;
+    }
+    /**
+     * @brief Get the size of the file.
+     *
+     * @return std::size_t the number of bytes
+     */
+    std::size_t size() const noexcept
+    {
+        return length;
+    }
+
+  private:
+    /**
+     * @brief Unmap the file, if it is mapped.
+     *
+     */
+    void unmap() noexcept;
+
+    /**
+     * @brief The mapped contents of the file.
+     *
+     */
+    const unsigned char *bytes;
+    /**
+     * @brief The number of bytes mapped.
+     *
+     */
+    std::size_t length;
+};
+} // namespace util
+
+#endif // UTIL_MAPPED_FILE_HH
@@ -8,9 +8,13 @@
 #ifndef UTIL_UTIL_HH
 #define UTIL_UTIL_HH
 
+#include <charconv>
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
 
 /**
  * @namespace util
@@ -115,13 +119,53 @@ template <typename T, typename... Ts> void print(T first, Ts... rest)
  */
 std::string trim(std::string_view s);
 
+/**
+ * @brief Parse an integer from a string without throwing. Unlike std::from_chars, a leading '+' is accepted, and
+ * unlike strtol, the string does not need to be null-terminated.
+ *
+ * @tparam T the integer type
+ * @param s the string, which must hold nothing but the integer
+ * @param value set to the integer if it is parsed
+ * @return std::errc std::errc() if it is parsed, std::errc::result_out_of_range if it does not fit in T, or
+ * std::errc::invalid_argument if the string is not an integer
+ */
+template <typename T> std::errc parseInt(std::string_view s, T &value) noexcept
+{
+    // from_chars accepts a '-' but not a '+'
+    if (s.size() > 1 && s[0] == '+' && s[1] != '-')
+    {
+        s.remove_prefix(1);
+    }
+    auto [end, status] = std::from_chars(s.data(), s.data() + s.size(), value);
+    if (status == std::errc() && end != s.data() + s.size())
+    {
+        return std::errc::invalid_argument;
+    }
+    return status;
+}
+
 /**
  * @brief Parse an integer from a string.
  *
+ * @tparam T the integer type
  * @param s the string
- * @return long the integer
+ * @return T the integer
+ * @throw std::runtime_error if the string is not an integer, or the integer does not fit in T
  */
-long parseInt(std::string_view s);
+template <typename T = long> T parseInt(std::string_view s)
+{
+    T value = 0;
+    std::errc status = parseInt(s, value);
+    if (status == std::errc::result_out_of_range)
+    {
+        throw std::runtime_error(concat("parsing integer: '", s, "' is out of range"));
+    }
+    if (status != std::errc())
+    {
+        throw std::runtime_error(concat("parsing integer: '", s, "' is not an integer"));
+    }
+    return value;
+}
 
 /**
  * @brief Convert `it` to a string representation. It must have an overloaded `operator<<` for ostreams.